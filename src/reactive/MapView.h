@@ -0,0 +1,140 @@
+#ifndef REACTIVE_MAPVIEW_H
+#define REACTIVE_MAPVIEW_H
+
+#include <memory>
+#include <functional>
+#include <limits>
+
+#include "details/ObservableMap.h"
+#include "details/MapView.h"
+#include "Subscription.h"
+
+namespace reactive{
+
+    // read-only part of ObservableMap handle. Result of filtered().
+    template<class K, class V, class Hash = std::hash<K>, std::size_t stripes = 64>
+    class MapView {
+    protected:
+        using Map = details::ObservableMap<K, V, Hash, stripes>;
+        std::shared_ptr<Map> ptr;
+    public:
+        using Key   = K;
+        using Value = V;
+        using WeakPtr   = std::weak_ptr<Map>;
+        using SharedPtr = std::shared_ptr<Map>;
+
+        MapView(const WeakPtr& weak)
+            : ptr(weak.lock()) {}
+        MapView(const SharedPtr& shared)
+            : ptr(shared) {}
+
+        WeakPtr weak_ptr() const{
+            return {ptr};
+        }
+        const SharedPtr& shared_ptr() const{
+            return ptr;
+        }
+        operator bool() const{
+            return ptr.operator bool();
+        }
+
+        // forward
+
+        nonstd::optional<V> get(const K& key) const {
+            return ptr->get(key);
+        }
+        bool contains(const K& key) const {
+            return ptr->contains(key);
+        }
+        std::size_t size() const {
+            return ptr->size();
+        }
+        template<class Fn>
+        void foreach(Fn&& fn) const {
+            ptr->foreach(std::forward<Fn>(fn));
+        }
+
+        // key subscription: fn(const K& key, const V* value), value nullptr - erased
+        template<class Fn>
+        Subscription subscribe(const K& key, Fn&& fn) const {
+            DelegateTag tag;
+            ptr->subscribe(key, tag, std::forward<Fn>(fn));
+            return [map = WeakPtr(ptr), key, tag]() {
+                if (SharedPtr ptr = map.lock()) ptr->unsubscribe(key, tag);
+            };
+        }
+
+        // bulk event: fn(const MapDiff<K>&)
+        template<class DelegateT>
+        void operator+=(DelegateT&& closure) const {
+            ptr->operator+=(std::forward<DelegateT>(closure));
+        }
+        template<class Fn>
+        void subscribe(const DelegateTag& tag, Fn&& fn) const {
+            ptr->subscribe(tag, std::forward<Fn>(fn));
+        }
+        template<class Delegate>
+        void operator-=(Delegate&& closure) const {
+            ptr->operator-=(std::forward<Delegate>(closure));
+        }
+    };
+
+
+    // Ordered window over map values. Event: (const VectorDiff&, const Range&), rank based.
+    template<class K, class V, class Less, class Hash = std::hash<K>, std::size_t stripes = 64>
+    class SortedMapView {
+        using View = details::SortedMap<K, V, Hash, stripes, Less>;
+        std::shared_ptr<View> ptr;
+    public:
+        using Range    = typename View::Range;
+        using ReadLock = typename View::ReadLock;
+
+        SortedMapView(std::shared_ptr<View> view)
+            : ptr(std::move(view)) {}
+
+        // size(), key(i), value(i), foreach(fn(key, value))
+        ReadLock lock() const {
+            return ptr->lock();
+        }
+
+        template<class DelegateT>
+        void operator+=(DelegateT&& closure) const {
+            ptr->operator+=(std::forward<DelegateT>(closure));
+        }
+        template<class Fn>
+        void subscribe(const DelegateTag& tag, Fn&& fn) const {
+            ptr->subscribe(tag, std::forward<Fn>(fn));
+        }
+        template<class Delegate>
+        void operator-=(Delegate&& closure) const {
+            ptr->operator-=(std::forward<Delegate>(closure));
+        }
+    };
+
+
+    // Views maintained incrementally from source bulk events, keep source alive.
+
+    // Keys, which value satisfies pred(const V&)
+    template<class K, class V, class Hash, std::size_t stripes, class Pred>
+    MapView<K, V, Hash, stripes> filtered(const MapView<K, V, Hash, stripes>& source, Pred&& pred) {
+        using View = details::FilteredMap<K, V, Hash, stripes, std::decay_t<Pred>>;
+        return View::make(source.shared_ptr(), std::forward<Pred>(pred));
+    }
+
+    // All values, ordered with less(const V&, const V&)
+    template<class K, class V, class Hash, std::size_t stripes, class Less = std::less<V>>
+    SortedMapView<K, V, Less, Hash, stripes> sorted(const MapView<K, V, Hash, stripes>& source, Less less = {}) {
+        using View = details::SortedMap<K, V, Hash, stripes, Less>;
+        return View::make(source.shared_ptr(), std::move(less), std::numeric_limits<std::size_t>::max());
+    }
+
+    // First k values, ordered with less(const V&, const V&)
+    template<class K, class V, class Hash, std::size_t stripes, class Less = std::less<V>>
+    SortedMapView<K, V, Less, Hash, stripes> top_k(const MapView<K, V, Hash, stripes>& source, std::size_t k, Less less = {}) {
+        using View = details::SortedMap<K, V, Hash, stripes, Less>;
+        return View::make(source.shared_ptr(), std::move(less), k);
+    }
+
+}
+
+#endif //REACTIVE_MAPVIEW_H
@@ -0,0 +1,53 @@
+#ifndef REACTIVE_OBSERVABLEMAP_H
+#define REACTIVE_OBSERVABLEMAP_H
+
+#include <memory>
+
+#include "details/ObservableMap.h"
+#include "MapView.h"
+
+namespace reactive{
+
+    // just wraps details::ObservableMap with shared_ptr
+    template<class K, class V, class Hash = std::hash<K>, std::size_t stripes = 64>
+    class ObservableMap : public MapView<K, V, Hash, stripes> {
+        using Base = MapView<K, V, Hash, stripes>;
+        using Map  = typename Base::Map;
+        using Base::ptr;
+    public:
+        using Batch = typename Map::Batch;
+        using typename Base::WeakPtr;
+        using typename Base::SharedPtr;
+
+        ObservableMap()
+            : Base(std::make_shared<Map>()) {}
+
+        ObservableMap(const WeakPtr& weak)
+            : Base(weak) {}
+        ObservableMap(const SharedPtr& shared)
+            : Base(shared) {}
+
+        ObservableMap(ObservableMap&&) = default;
+        ObservableMap& operator=(ObservableMap&&) = default;
+
+        // forward
+
+        template<class Value>
+        void set(const K& key, Value&& value) {
+            ptr->set(key, std::forward<Value>(value));
+        }
+        bool erase(const K& key) {
+            return ptr->erase(key);
+        }
+        template<class Fn>
+        bool update(const K& key, Fn&& fn) {
+            return ptr->update(key, std::forward<Fn>(fn));
+        }
+        Batch batch() {
+            return ptr->batch();
+        }
+    };
+
+}
+
+#endif //REACTIVE_OBSERVABLEMAP_H
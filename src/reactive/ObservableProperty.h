@@ -1,36 +1,42 @@
 #ifndef REACTIVE_OBSERVABLEPROPERTY_H
 #define REACTIVE_OBSERVABLEPROPERTY_H
 
+#include <memory>
+
 #include "details/ObservableProperty.h"
+#include "details/Pointer.h"
 
 namespace reactive{
 
 	class ObservablePropertyBase {};
 
     // just wraps details::ObservableProperty with shared_ptr
-    template<class T, class blocking_class = default_blocking, bool t_threadsafe = true>
+    // change_detection_policy - see reactive/change_detection.h
+    // pointer - smart pointer family, which owns property (details::std_pointer / intrusive::pointer)
+    template<class T, class blocking_class = default_blocking, bool t_threadsafe = true, class change_detection_policy = reactive::change_detection::equal, class pointer = details::std_pointer>
     class ObservableProperty : ObservablePropertyBase {
 	public:
 		static constexpr const bool threadsafe = t_threadsafe;
 	private:
-        using Self = ObservableProperty<T, blocking_class, threadsafe>;
+        using Self = ObservableProperty<T, blocking_class, threadsafe, change_detection_policy, pointer>;
 
         using Property = std::conditional_t<threadsafe
-			, details::ObservableProperty<T, blocking_class, Self>
-			, details::ObservablePropertyConfigurable<T, blocking, Self, threading::dummy_mutex, threading::dummy_mutex, threading::dummy_mutex>
+			, details::ObservableProperty<T, blocking_class, Self, change_detection_policy>
+			, details::ObservablePropertyConfigurable<T, blocking, Self, threading::dummy_mutex, threading::dummy_mutex, threading::dummy_mutex, change_detection_policy>
 		>;
-        std::shared_ptr<Property> ptr;
+        using SharedPtr_ = typename pointer::template shared_ptr<Property>;
+        SharedPtr_ ptr;
     public:
 		using Value = T;
-        using WeakPtr   = std::weak_ptr<Property>;
-        using SharedPtr = std::shared_ptr<Property>;
+        using WeakPtr   = typename pointer::template weak_ptr<Property>;
+        using SharedPtr = SharedPtr_;
         using ReadLock  = typename Property::ReadLock;
         using WriteLock = typename Property::WriteLock;
 
 		//using blocking_mode = typename Property::blocking_mode;
 
         ObservableProperty()
-            : ptr(std::make_shared<Property>()){};
+            : ptr(pointer::template make_shared<Property>()){};
 
         ObservableProperty(const WeakPtr& weak)
             : ptr(weak.lock()){};
@@ -51,14 +57,14 @@ namespace reactive{
                 >
         >
         ObservableProperty(Arg&& arg, Args&&...args)
-            : ptr(std::make_shared<Property>(std::forward<Arg>(arg), std::forward<Args>(args)...) ) {};
+            : ptr(pointer::template make_shared<Property>(std::forward<Arg>(arg), std::forward<Args>(args)...) ) {};
 
 
         ObservableProperty(ObservableProperty&&) = default;
         ObservableProperty& operator=(ObservableProperty&&) = default;
 
         ObservableProperty(const ObservableProperty& other)
-            :ptr(std::make_shared<Property>(other.getCopy())) {}
+            :ptr(pointer::template make_shared<Property>(other.getCopy())) {}
         ObservableProperty& operator=(const ObservableProperty& other) {
             *ptr = *(other.ptr);
             return *this;
@@ -101,6 +107,24 @@ namespace reactive{
             ptr->operator=(std::move(value));
         }
 
+        // lock-free read-modify-write (nonblocking_atomic only)
+        template<class Fn>
+        T modify(Fn&& fn) {
+            return ptr->modify(std::forward<Fn>(fn));
+        }
+        T fetch_add(const T& arg) {
+            return ptr->fetch_add(arg);
+        }
+        T fetch_sub(const T& arg) {
+            return ptr->fetch_sub(arg);
+        }
+        T exchange(const T& value) {
+            return ptr->exchange(value);
+        }
+        bool compare_exchange(T& expected, const T& desired) {
+            return ptr->compare_exchange(expected, desired);
+        }
+
 		template<bool m_threadsafe = threadsafe, typename = std::enable_if_t<!m_threadsafe> >
 		const T* operator->() const {
 			return &(ptr->value);
@@ -123,6 +147,38 @@ namespace reactive{
         void pulse() const{
             ptr->pulse();
         }
+
+        // change_detection::bitwise_range only
+        change_detection::range changed_range() const{
+            return ptr->changed_range();
+        }
+
+        // blocking wait (futex), no subscription
+        unsigned version() const{
+            return ptr->version();
+        }
+        unsigned wait_for_change(unsigned version) const{
+            return ptr->wait_for_change(version);
+        }
+        template<class Pred>
+        T wait_until(Pred&& pred) const{
+            return ptr->wait_until(std::forward<Pred>(pred));
+        }
+
+#if defined(__cpp_impl_coroutine)
+        // co_await x.next() - next value; co_await x.until(pred) - current or next value, which satisfy pred.
+        auto next() const {
+            return details::coroutine::next(ptr);
+        }
+        template<class Pred>
+        auto until(Pred&& pred) const {
+            return details::coroutine::until(ptr, std::forward<Pred>(pred));
+        }
+        // conflating async generator: auto values = x.values(); co_await values.next()
+        auto values() const {
+            return details::coroutine::values(ptr);
+        }
+#endif
     };
 
 }
@@ -0,0 +1,111 @@
+#ifndef REACTIVE_OBSERVABLEPROPERTYARRAY_H
+#define REACTIVE_OBSERVABLEPROPERTYARRAY_H
+
+#include <memory>
+
+#include "details/ObservablePropertyArray.h"
+
+namespace reactive{
+
+    // just wraps details::ObservablePropertyArray with shared_ptr
+    template<class T, std::size_t stripes = 64>
+    class ObservablePropertyArray {
+        using Array = details::ObservablePropertyArray<T, stripes>;
+        std::shared_ptr<Array> ptr;
+    public:
+        using Value = T;
+        using WeakPtr   = std::weak_ptr<Array>;
+        using SharedPtr = std::shared_ptr<Array>;
+
+        // Lightweight element handle, usable as property in observe / bind / ReactiveProperty::set.
+        // Keeps array alive.
+        class Element {
+            friend ObservablePropertyArray;
+            std::shared_ptr<Array> array;
+            std::size_t m_index;
+
+            Element(std::shared_ptr<Array> array, std::size_t index)
+                : array(std::move(array))
+                , m_index(index) {}
+        public:
+            using Value = T;
+
+            std::size_t index() const {
+                return m_index;
+            }
+
+            // observable node, shares array ownership
+            std::shared_ptr<typename Array::Element> shared_ptr() const {
+                return { array, &array->element(m_index) };
+            }
+
+            T getCopy() const {
+                return array->get(m_index);
+            }
+            template<class Value>
+            void set(Value&& value) {
+                array->set(m_index, std::forward<Value>(value));
+            }
+            template<class Value>
+            Element& operator=(Value&& value) {
+                set(std::forward<Value>(value));
+                return *this;
+            }
+            template<class Fn>
+            void modify(Fn&& fn) {
+                array->modify(m_index, std::forward<Fn>(fn));
+            }
+            void pulse() const {
+                array->pulse(m_index);
+            }
+        };
+
+        explicit ObservablePropertyArray(std::size_t size, const T& value = T())
+            : ptr(std::make_shared<Array>(size, value)) {}
+
+        ObservablePropertyArray(const WeakPtr& weak)
+            : ptr(weak.lock()) {}
+        ObservablePropertyArray(const SharedPtr& shared)
+            : ptr(shared) {}
+
+        ObservablePropertyArray(ObservablePropertyArray&&) = default;
+        ObservablePropertyArray& operator=(ObservablePropertyArray&&) = default;
+
+        WeakPtr weak_ptr() const{
+            return {ptr};
+        }
+        const SharedPtr& shared_ptr() const{
+            return ptr;
+        }
+        operator bool() const{
+            return ptr.operator bool();
+        }
+
+        Element operator[](std::size_t index) const {
+            return { ptr, index };
+        }
+
+        // forward
+
+        std::size_t size() const {
+            return ptr->size();
+        }
+        T get(std::size_t index) const {
+            return ptr->get(index);
+        }
+        template<class Value>
+        void set(std::size_t index, Value&& value) {
+            ptr->set(index, std::forward<Value>(value));
+        }
+        template<class Fn>
+        void modify(std::size_t index, Fn&& fn) {
+            ptr->modify(index, std::forward<Fn>(fn));
+        }
+        void pulse(std::size_t index) const {
+            ptr->pulse(index);
+        }
+    };
+
+}
+
+#endif //REACTIVE_OBSERVABLEPROPERTYARRAY_H
@@ -0,0 +1,84 @@
+#ifndef REACTIVE_OBSERVABLEVECTOR_H
+#define REACTIVE_OBSERVABLEVECTOR_H
+
+#include <memory>
+
+#include "details/ObservableVector.h"
+
+namespace reactive{
+
+    // just wraps details::ObservableVector with shared_ptr
+    // Event: (const VectorDiff&, const std::vector<T>&), called once per write scope, under read lock.
+    template<class T>
+    class ObservableVector {
+        using Vector = details::ObservableVector<T>;
+        std::shared_ptr<Vector> ptr;
+    public:
+        using Value = std::vector<T>;
+        using WeakPtr   = std::weak_ptr<Vector>;
+        using SharedPtr = std::shared_ptr<Vector>;
+        using ReadLock  = typename Vector::ReadLock;
+        using WriteLock = typename Vector::WriteLock;
+
+        ObservableVector()
+            : ptr(std::make_shared<Vector>()) {}
+        ObservableVector(std::vector<T> values)
+            : ptr(std::make_shared<Vector>(std::move(values))) {}
+        ObservableVector(std::initializer_list<T> values)
+            : ptr(std::make_shared<Vector>(std::vector<T>(values))) {}
+
+        ObservableVector(const WeakPtr& weak)
+            : ptr(weak.lock()) {}
+        ObservableVector(const SharedPtr& shared)
+            : ptr(shared) {}
+
+        ObservableVector(ObservableVector&&) = default;
+        ObservableVector& operator=(ObservableVector&&) = default;
+
+        // copy only values
+        ObservableVector(const ObservableVector& other)
+            : ptr(std::make_shared<Vector>(other.getCopy())) {}
+
+        WeakPtr weak_ptr() const{
+            return {ptr};
+        }
+        const SharedPtr& shared_ptr() const{
+            return ptr;
+        }
+        operator bool() const{
+            return ptr.operator bool();
+        }
+
+        // forward
+
+        template<class DelegateT>
+        void operator+=(DelegateT&& closure) const {
+            ptr->operator+=(std::forward<DelegateT>(closure));
+        }
+        template<class Fn>
+        void subscribe(const DelegateTag& tag, Fn&& fn) const {
+            ptr->subscribe(tag, std::forward<Fn>(fn));
+        }
+        template<class Delegate>
+        void operator-=(Delegate&& closure) const {
+            ptr->operator-=(std::forward<Delegate>(closure));
+        }
+
+        ReadLock lock() const {
+            return ptr->lock();
+        }
+        WriteLock write_lock() {
+            return ptr->write_lock();
+        }
+        std::vector<T> getCopy() const{
+            return ptr->getCopy();
+        }
+
+        void operator=(std::vector<T> values) {
+            ptr->operator=(std::move(values));
+        }
+    };
+
+}
+
+#endif //REACTIVE_OBSERVABLEVECTOR_H
@@ -3,22 +3,30 @@
 
 #include <reactive/details/ObservableProperty.h>
 #include "observer.h"
+#include "dynamic_observer.h"
+#include "expression.h"
+#include "operators.h"
+#include "Scheduler.h"
+#include "details/utils/optional.hpp"
+#include "details/Pointer.h"
 
 namespace reactive{
 
 	class ReactivePropertyBase {};
 
-    template<class T, class blocking_class = reactive::default_blocking, bool t_threadsafe = true >
+    // change_detection_policy - see reactive/change_detection.h
+    // pointer - smart pointer family, which owns data (details::std_pointer / intrusive::pointer)
+    template<class T, class blocking_class = reactive::default_blocking, bool t_threadsafe = true, class change_detection_policy = reactive::change_detection::equal, class pointer = details::std_pointer>
     class ReactiveProperty : ReactivePropertyBase {
 	public:
 		static constexpr const bool threadsafe = t_threadsafe;
 	private:
-        using Self = ReactiveProperty<T, blocking_class, threadsafe>;
+        using Self = ReactiveProperty<T, blocking_class, threadsafe, change_detection_policy, pointer>;
 
 		using DataBase = 
 			std::conditional_t<threadsafe
-				, details::ObservableProperty<T, blocking_class, Self>
-				, details::ObservablePropertyConfigurable<T, blocking_class, Self, threading::dummy_mutex, threading::dummy_mutex, threading::dummy_mutex>
+				, details::ObservableProperty<T, blocking_class, Self, change_detection_policy>
+				, details::ObservablePropertyConfigurable<T, blocking_class, Self, threading::dummy_mutex, threading::dummy_mutex, threading::dummy_mutex, change_detection_policy>
 			>;
 
 		struct DataNoLock {
@@ -65,21 +73,106 @@ namespace reactive{
 				return get_mutex(std::integral_constant<bool, DataLock::base_have_lock>{});
 			}
 
-            std::function<void()> unsubscriber;
+            Subscription unsubscriber;
+            details::scheduler::Rank<Lock> scheduler_rank;    // see Scheduler
         };
 
-        std::shared_ptr<Data> ptr;
+        using DataPtr     = typename pointer::template shared_ptr<Data>;
+        using DataWeakPtr = typename pointer::template weak_ptr<Data>;
+        DataPtr ptr;
+
+        // Observer closures for set / update. Named - to find observer of previous set/update.
+        // User closure called under get_mutex, so it can be swapped in place, see rebind().
+        // get_mutex always taken after observables read-locked (blocking), never before - set() / update()
+        // release it before initial execute().
+        template<class Closure>
+        struct SetClosure {
+            DataPtr ptr;
+            nonstd::optional<Closure> closure;
+
+            template<class ...Args>
+            void operator()(Args&&...args) const {
+                std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
+                ptr->set_value((*closure)(std::forward<Args>(args)...), std::move(l));
+            }
+        };
+        template<class Closure>
+        struct UpdateClosure {
+            DataPtr ptr;
+            nonstd::optional<Closure> closure;
+
+            template<class ...Args>
+            void operator()(Args&&...args) const {
+                std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
+                auto write_ptr = ptr->write_lock(std::move(l));
+                (*closure)(write_ptr.get(), std::forward<Args>(args)...);
+            }
+        };
+
+        // see Scheduler. Under get_mutex, observer held by ptr->unsubscriber.
+        template<class ObserverPtr>
+        void store_rank(const ObserverPtr& observer) {
+            using Observer = std::decay_t<decltype(*observer)>;
+            ptr->scheduler_rank.store(&details::scheduler::observer_inputs_rank<typename DataLock::Lock, Observer>, &*observer);
+        }
+
+        template<class ObserverPtr>
+        struct Unsubscriber {
+            ObserverPtr observer;
+
+            void operator()() const {
+                observer->unsubscribe();
+            }
+        };
+
+        template<class WeakPtrs, class ...ObservablePtrs, std::size_t ...Is>
+        static bool same_observables(const WeakPtrs& weak_ptrs, std::index_sequence<Is...>
+            , const ObservablePtrs&... observables)
+        {
+            return details::MultiObserver::and_all(
+                (!std::get<Is>(weak_ptrs).owner_before(observables) && !observables.owner_before(std::get<Is>(weak_ptrs)))...
+            );
+        }
+
+        // If previous set/update observe the same observables, with the same closure type -
+        // swap closure in place, instead of re-subscribing. Must be called under get_mutex.
+        // Return observer or nullptr.
+        template<class ObserverClosure, class blocking_mode, class Closure, class ...ObservablePtrs>
+        auto rebind(Closure&& closure, const ObservablePtrs&... observables){
+            using ObserverPtr = decltype(
+                details::MultiObserver::observe_impl<blocking_mode>(std::declval<ObserverClosure>(), observables...)
+            );
+
+            Unsubscriber<ObserverPtr>* unsubscriber = ptr->unsubscriber.template target<Unsubscriber<ObserverPtr>>();
+            if (!unsubscriber
+                || !same_observables(unsubscriber->observer->observable_weak_ptrs, std::index_sequence_for<ObservablePtrs...>{}, observables...))
+            {
+                return ObserverPtr();
+            }
+
+            unsubscriber->observer->closure.closure.emplace(std::forward<Closure>(closure));
+            return unsubscriber->observer;
+        }
+
+        // Observer closures hold Data (no weak_ptr::lock per update).
+        // Data <-> observer cycle broken here. Must be called under get_mutex.
+        void unsubscribe_previous(){
+            if (!ptr->unsubscriber) return;
+
+            Subscription unsubscriber = std::move(ptr->unsubscriber);
+            unsubscriber();
+        }
     public:
 		using Value = T;
-        using WeakPtr   = std::weak_ptr<Data>;
-        using SharedPtr = std::shared_ptr<Data>;
+        using WeakPtr   = DataWeakPtr;
+        using SharedPtr = DataPtr;
         using ReadLock  = typename Data::ReadLock;
         using WriteLock = typename Data::WriteLock;
 		//using blocking_mode = typename DataBase::blocking_mode;
 
 
         ReactiveProperty()
-            : ptr(std::make_shared<Data>()){};
+            : ptr(pointer::template make_shared<Data>()){};
 
         ReactiveProperty(const WeakPtr& weak)
             : ptr(weak.lock()){};
@@ -90,8 +183,8 @@ namespace reactive{
 			: ptr(std::move(shared)) {};
 
 
-        template<class any_mode>
-        ReactiveProperty(const ObservableProperty<T, any_mode>& other)
+        template<class any_mode, class any_change_detection, class any_pointer>
+        ReactiveProperty(const ObservableProperty<T, any_mode, true, any_change_detection, any_pointer>& other)
             : ReactiveProperty(other.getCopy())
         {
             set_impl<false>([](const T& value) -> const T& {
@@ -112,6 +205,8 @@ namespace reactive{
 
 				|| std::is_base_of<ObservablePropertyBase, std::decay_t<Arg>>::value
 				|| std::is_base_of<ReactivePropertyBase, std::decay_t<Arg>>::value
+				|| std::is_base_of<ExpressionBase, std::decay_t<Arg>>::value
+				|| std::is_base_of<PipelineBase, std::decay_t<Arg>>::value
 
                 /*|| std::is_same< std::decay_t<Arg>, ObservableProperty<T, reactive::default_blocking> >::value
                 || std::is_same< std::decay_t<Arg>, ObservableProperty<T, reactive::nonblocking> >::value
@@ -121,7 +216,25 @@ namespace reactive{
             >
         >
         ReactiveProperty(Arg&& arg, Args&&...args)
-            : ptr(std::make_shared<Data>(std::forward<Arg>(arg), std::forward<Args>(args)...) ) {};
+            : ptr(pointer::template make_shared<Data>(std::forward<Arg>(arg), std::forward<Args>(args)...) ) {};
+
+
+        // expression evaluated in one node, see set(expression)
+        template<class Expression, class = std::enable_if_t< details::expression::is_expression<Expression>::value >>
+        ReactiveProperty(const Expression& expression)
+            : ReactiveProperty()
+        {
+            set(expression);
+        }
+
+
+        // see set(pipeline)
+        template<class Pipeline, class = std::enable_if_t< details::operators::is_pipeline<Pipeline>::value >, class = void>
+        ReactiveProperty(const Pipeline& pipeline)
+            : ReactiveProperty()
+        {
+            set(pipeline);
+        }
 
 
         // copy ctr, as listener
@@ -156,11 +269,25 @@ namespace reactive{
             set_assigment(other);
             return *this;
         }
+        template<class Expression, class = std::enable_if_t< details::expression::is_expression<Expression>::value >>
+        ReactiveProperty& operator=(const Expression& expression){
+            set(expression);
+            return *this;
+        }
+        template<class Pipeline, class = std::enable_if_t< details::operators::is_pipeline<Pipeline>::value >, class = void>
+        ReactiveProperty& operator=(const Pipeline& pipeline){
+            set(pipeline);
+            return *this;
+        }
 
 
 		ReactiveProperty(ReactiveProperty&& other) noexcept
 			:ptr(std::move(other.ptr)) {}
 		ReactiveProperty& operator=(ReactiveProperty&& other) noexcept {
+			if (ptr) {
+				std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
+				unsubscribe_previous();
+			}
 			ptr = std::move(other.ptr);
 			return *this;
 		}
@@ -168,57 +295,218 @@ namespace reactive{
     private:
         template<bool update_value = true, class set_blocking_mode = reactive::default_blocking, class Closure, class ...Observables>
         void set_impl(Closure&& closure, const Observables&... observables){
-            std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
+            set_ptr_impl<update_value, set_blocking_mode>(std::forward<Closure>(closure), observables.shared_ptr()...);
+        }
 
-            if (ptr->unsubscriber){
-                ptr->unsubscriber();
-            }
+        template<bool update_value = true, class set_blocking_mode = reactive::default_blocking, class Closure, class ...ObservablePtrs>
+        void set_ptr_impl(Closure&& closure, const ObservablePtrs&... observables){
+            using ObserverClosure = SetClosure<std::decay_t<Closure>>;
+            std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
 
-            auto observer = reactive::details::MultiObserver::observe_impl<set_blocking_mode>(
-			[closure = std::forward<Closure>(closure), ptr_weak = std::weak_ptr<Data>(ptr)](auto&&...args){
-                std::shared_ptr<Data> ptr = ptr_weak.lock();
-                if(!ptr) return;
+            auto observer = rebind<ObserverClosure, set_blocking_mode>(std::forward<Closure>(closure), observables...);
+            if (!observer) {
+                unsubscribe_previous();
 
-                (*ptr) = closure(std::forward<decltype(args)>(args)...);
-            }, observables.shared_ptr()...);
+                observer = reactive::details::MultiObserver::observe_impl<set_blocking_mode>(
+                    ObserverClosure{ ptr, nonstd::optional<std::decay_t<Closure>>(std::forward<Closure>(closure)) }
+                , observables...);
 
-            ptr->unsubscriber = [observer](){ observer->unsubscribe(); };
+                ptr->unsubscriber = Unsubscriber<decltype(observer)>{ observer };
+                store_rank(observer);
+            }
 
             if (update_value) {
-                observer->execute([&](auto &&...args) {
-                    ptr->set_value(closure(std::forward<decltype(args)>(args)...), std::move(l));
-                });
+                // SetClosure takes get_mutex after observables read-locked - same order as on change
+                l.unlock();
+                observer->execute();
             }
         }
     public:
         template<class set_blocking_mode = reactive::default_blocking, class Closure, class ...Observables>
-        void set(Closure&& closure, const Observables&... observables){
+        std::enable_if_t<(sizeof...(Observables) > 0)>
+        set(Closure&& closure, const Observables&... observables){
             set_impl<true, set_blocking_mode>(std::forward<Closure>(closure), observables...);
         }
 
+        // x1 + x2 * x3 ... evaluated in one reactive node, without intermediate properties.
+        template<class set_blocking_mode = reactive::default_blocking, class Expression>
+        std::enable_if_t<details::expression::is_expression<Expression>::value>
+        set(const Expression& expression){
+            details::expression::apply_leaves(expression, [&](const auto&... observables){
+                set_ptr_impl<true, set_blocking_mode>(details::expression::make_closure(expression), observables...);
+            });
+        }
+
+
+        // from(x) | map(...) | filter(...) ... - whole chain is one observer, property is set on each chain output.
+        // If chain source(s) are properties, value set right away.
+        template<class Pipeline>
+        std::enable_if_t<details::operators::is_pipeline<Pipeline>::value>
+        set(const Pipeline& pipeline){
+            // pipeline holds sources strong - rank fixed at set. Sources' locks taken before own.
+            const unsigned rank = pipeline.rank();
+
+            std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
+
+            unsubscribe_previous();
+
+            auto subscribed = pipeline.subscribe_unprimed([ptr = ptr](const auto& value){
+                std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
+                ptr->set_value(value, std::move(l));
+            });
+
+            ptr->unsubscriber = std::move(subscribed.first);
+            ptr->scheduler_rank.store(rank);
+
+            l.unlock();
+            subscribed.second();
+        }
+
+
+        // Same as set, but recomputed only on scheduler.flush(), once per flush. See Scheduler.
+        template<class set_blocking_mode = reactive::default_blocking, class Closure, class ...Observables>
+        void set_deferred(Scheduler& scheduler, Closure&& closure, const Observables&... observables){
+            // inputs' locks taken before own
+            const unsigned rank = details::scheduler::rank(observables.shared_ptr()...);
+
+            std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
+
+            unsubscribe_previous();
+
+            auto node = details::scheduler::observe_impl<set_blocking_mode>(scheduler, rank,
+            [closure = std::forward<Closure>(closure), ptr = ptr](auto&&...args){
+                (*ptr) = closure(std::forward<decltype(args)>(args)...);
+            }, observables.shared_ptr()...);
+
+            ptr->unsubscriber = [node](){ node->unsubscribe(); };
+            using Node = typename decltype(node)::element_type;
+            ptr->scheduler_rank.store(&Node::template node_inputs_rank<typename DataLock::Lock>, node.get());
+
+            l.unlock();
+            node->run();
+        }
+
+
+        // Same as set, but closure computed on executor: executor(task), task is void().
+        // Each input change starts new computation, tagged with input generation.
+        // Computation, which inputs changed before it started or finished, is discarded - only newest result published.
+        // Re-set / assignment cancels computations in flight.
+        template<class set_blocking_mode = reactive::default_blocking, class Executor, class Closure, class ...Observables>
+        void set_async(Executor&& executor, Closure&& closure, const Observables&... observables){
+            static constexpr const unsigned long long cancelled = 1ull << 63;
+
+            struct Async {
+                std::decay_t<Executor> executor;
+                std::decay_t<Closure> closure;
+                std::atomic<unsigned long long> generation{0};     // high bit - cancelled
+
+                Async(Executor&& executor, Closure&& closure)
+                    : executor(std::forward<Executor>(executor))
+                    , closure(std::forward<Closure>(closure)) {}
+            };
+
+            std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
+
+            unsubscribe_previous();
+
+            auto async = std::make_shared<Async>(std::forward<Executor>(executor), std::forward<Closure>(closure));
+
+            auto launch = [async, ptr_weak = DataWeakPtr(ptr)](auto&&...args){
+                const unsigned long long generation = async->generation.fetch_add(1) + 1;
+                if (generation & cancelled) return;
+
+                async->executor([
+                    async, ptr_weak, generation
+                    , values = std::make_tuple(std::decay_t<decltype(args)>(std::forward<decltype(args)>(args))...)
+                ](){
+                    if (async->generation.load() != generation) return;
+
+                    DataPtr ptr = ptr_weak.lock();
+                    if(!ptr) return;
+
+                    T value = details::expression::apply(async->closure, values);
+
+                    std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
+                    if (async->generation.load() != generation) return;
+                    ptr->set_value(std::move(value), std::move(l));
+                });
+            };
+
+            auto observer = reactive::details::MultiObserver::observe_impl<set_blocking_mode>(launch, observables.shared_ptr()...);
+
+            // under get_mutex - computations in flight will not publish
+            ptr->unsubscriber = [observer, async](){
+                observer->unsubscribe();
+                async->generation.fetch_or(cancelled);
+            };
+            store_rank(observer);
+
+            l.unlock();
+            observer->execute(launch);
+        }
+
 
         template<class update_blocking_mode = reactive::default_blocking, class Closure, class ...Observables>
         void update(Closure&& closure, const Observables&... observables){
+            using ObserverClosure = UpdateClosure<std::decay_t<Closure>>;
             std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
 
-            if (ptr->unsubscriber){
-                ptr->unsubscriber();
+            auto observer = rebind<ObserverClosure, update_blocking_mode>(std::forward<Closure>(closure), observables.shared_ptr()...);
+            if (!observer) {
+                unsubscribe_previous();
+
+                observer = reactive::details::MultiObserver::observe_impl<update_blocking_mode>(
+                    ObserverClosure{ ptr, nonstd::optional<std::decay_t<Closure>>(std::forward<Closure>(closure)) }
+                , observables.shared_ptr()...);
+
+                ptr->unsubscriber = Unsubscriber<decltype(observer)>{ observer };
+                store_rank(observer);
             }
 
-            auto observer = reactive::details::MultiObserver::observe_impl<update_blocking_mode>(
-			[closure = std::forward<Closure>(closure), ptr_weak = std::weak_ptr<Data>(ptr)](auto&&...args){
-                std::shared_ptr<Data> ptr = ptr_weak.lock();
-                if(!ptr) return;
+            // UpdateClosure takes get_mutex after observables read-locked - same order as on change
+            l.unlock();
+            observer->execute();
+        }
+
 
-                auto write_ptr = ptr->write_lock();
-                closure(write_ptr.get(), std::forward<decltype(args)>(args)...);
-            }, observables.shared_ptr()...);
 
-            ptr->unsubscriber = [observer](){ observer->unsubscribe(); };
+        // accumulate runtime-sized list of observables, O(1) per change.
+        // add(T& accumulator, const Value& value), remove(T& accumulator, const Value& value)
+        // remove must be inverse of add (sum, xor, counters...)
+        template<class Add, class Remove, class Observable>
+        void reduce(const T& init, Add&& add, Remove&& remove, const std::vector<Observable>& observables){
+            std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
+
+            unsubscribe_previous();
 
-            observer->execute([&](auto &&...args) {
+            // set under get_mutex - drain in flight will not apply to next set / reduce
+            auto cancelled = std::make_shared<std::atomic<bool>>(false);
+
+            auto observer = reactive::details::DynamicObserver::observe_impl(
+            [add, remove, ptr = ptr, cancelled](std::size_t, const auto& old_value, const auto& new_value){
+                std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
+                if (cancelled->load()) return;
+                auto write_ptr = ptr->write_lock(std::move(l));
+                remove(write_ptr.get(), old_value);
+                add(write_ptr.get(), new_value);
+            }, observables);
+
+            ptr->unsubscriber = [observer, cancelled](){
+                observer->unsubscribe();
+                cancelled->store(true);
+            };
+            store_rank(observer);
+
+            // closures take get_mutex after observer's drain lock - same order as on change
+            l.unlock();
+            observer->execute([&](const auto& values) {
+                std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
+                if (cancelled->load()) return;
                 auto write_ptr = ptr->write_lock(std::move(l));
-                closure(write_ptr.get(), std::forward<decltype(args)>(args)...);
+                write_ptr.get() = init;
+                for (const auto& value : values) {
+                    add(write_ptr.get(), value);
+                }
             });
         }
 
@@ -253,16 +541,12 @@ namespace reactive{
 
         void operator=(const T& value) {
             std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
-            if (ptr->unsubscriber){
-                ptr->unsubscriber();
-            }
+            unsubscribe_previous();
             ptr->set_value(value, std::move(l));
         }
         void operator=(T&& value) {
             std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
-            if (ptr->unsubscriber){
-                ptr->unsubscriber();
-            }
+            unsubscribe_previous();
             ptr->set_value(std::move(value), std::move(l));
         }
 
@@ -273,9 +557,7 @@ namespace reactive{
         }
         WriteLock write_lock() {
             std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
-            if (ptr->unsubscriber){
-                ptr->unsubscriber();
-            }
+            unsubscribe_previous();
             return ptr->write_lock(std::move(l));
         }
         T getCopy() const{
@@ -296,16 +578,53 @@ namespace reactive{
             ptr->pulse();
         }
 
+        // change_detection::bitwise_range only
+        change_detection::range changed_range() const{
+            return ptr->changed_range();
+        }
+
+        // blocking wait (futex), no subscription
+        unsigned version() const{
+            return ptr->version();
+        }
+        unsigned wait_for_change(unsigned version) const{
+            return ptr->wait_for_change(version);
+        }
+        template<class Pred>
+        T wait_until(Pred&& pred) const{
+            return ptr->wait_until(std::forward<Pred>(pred));
+        }
+
+#if defined(__cpp_impl_coroutine)
+        // co_await x.next() - next value; co_await x.until(pred) - current or next value, which satisfy pred.
+        auto next() const {
+            return details::coroutine::next(ptr);
+        }
+        template<class Pred>
+        auto until(Pred&& pred) const {
+            return details::coroutine::until(ptr, std::forward<Pred>(pred));
+        }
+        // conflating async generator: auto values = x.values(); co_await values.next()
+        auto values() const {
+            return details::coroutine::values(ptr);
+        }
+#endif
+
         ~ReactiveProperty(){			
 			if (!ptr) return; // moved?
 
             std::unique_lock<typename DataLock::Lock> l(ptr->get_mutex());
-            if (ptr->unsubscriber){
-                ptr->unsubscriber();
-            }
+            unsubscribe_previous();
         }
 
     };
+
+
+    // ReactiveProperty with value type deduced from expression
+    template<class Expression, class = std::enable_if_t< details::expression::is_expression<Expression>::value >>
+    auto make_reactive(const Expression& expression){
+        return ReactiveProperty<details::expression::result_t<Expression>>(expression);
+    }
 }
 
 #endif //TEST_REACTIVEPROPERTY2_H
\ No newline at end of file
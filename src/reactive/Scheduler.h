@@ -0,0 +1,355 @@
+#ifndef REACTIVE_SCHEDULER_H
+#define REACTIVE_SCHEDULER_H
+
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+#include <atomic>
+#include <tuple>
+#include <algorithm>
+
+#include "details/threading/SpinLock.h"
+#include "details/threading/WorkStealingPool.h"
+#include "observer.h"
+
+namespace reactive{
+
+    class Scheduler;
+
+    namespace details{
+    namespace scheduler{
+
+        // Deferred reactive node.
+        // rank = 1 + max(rank of inputs). Node depends only on nodes with lower rank.
+        // Inputs may be re-set deeper after node created - flush() checks live_rank() before run.
+        class Node {
+            friend Scheduler;
+            std::atomic<bool> dirty{false};
+        protected:
+            std::atomic<bool> unsubscribed{false};
+        public:
+            unsigned rank;      // only grows; changed by Scheduler, under its lock
+
+            Node(unsigned rank)
+                : rank(rank) {}
+
+            virtual unsigned live_rank() = 0;
+            virtual void run() = 0;
+            virtual void unsubscribe() = 0;
+
+            virtual ~Node() {}
+        };
+
+
+        // bumped on re-set of ReactiveProperty, which rank was ever loaded - cached ranks are stale
+        inline std::atomic<unsigned>& rank_epoch() {
+            static std::atomic<unsigned> epoch{1};
+            return epoch;
+        }
+
+        // Rank of ReactiveProperty - 1 + max(rank of inputs of current observer).
+        // Computed on first load (only Scheduler loads), cached until some ranked property re-set.
+        // store() per re-set - two pointers, no allocation; global epoch touched only if rank was loaded.
+        // Never decreases.
+        template<class Lock>
+        class Rank {
+        public:
+            // Copy inputs of observer, unlock l, return their rank.
+            // observer alive while l locked (held by owner's current subscription).
+            using InputsRank = unsigned (*)(const void* observer, std::unique_lock<Lock>& l);
+        private:
+            // under owner's lock
+            InputsRank inputs_rank = nullptr;
+            const void* observer = nullptr;
+            unsigned fixed = 0;
+            bool loaded = false;
+
+            std::atomic<unsigned> value{0};
+            std::atomic<unsigned> epoch{0};
+
+            void changed() {
+                if (loaded) rank_epoch().fetch_add(1);
+            }
+        public:
+            // under owner's lock
+            void store(InputsRank inputs_rank, const void* observer) {
+                this->inputs_rank = inputs_rank;
+                this->observer    = observer;
+                changed();
+            }
+            void store(unsigned fixed) {
+                inputs_rank = nullptr;
+                observer    = nullptr;
+                this->fixed = fixed;
+                changed();
+            }
+
+            // mutex - owner's lock. Not under it.
+            unsigned load(Lock& mutex) {
+                const unsigned current = rank_epoch().load();
+                if (epoch.load(std::memory_order_acquire) == current) return value.load(std::memory_order_relaxed);
+
+                std::unique_lock<Lock> l(mutex);
+                loaded = true;
+                // inputs form DAG - upstream ranks loaded with owner's lock released
+                const unsigned rank = inputs_rank ? inputs_rank(observer, l) : fixed;
+
+                unsigned old = value.load();
+                while (old < rank && !value.compare_exchange_weak(old, rank)) {}
+                epoch.store(current, std::memory_order_release);
+                return std::max(old, rank);
+            }
+        };
+
+
+        template<class SharedPtr>
+        static auto rank_of(const SharedPtr& ptr, int) -> decltype(ptr->scheduler_rank.load(ptr->get_mutex()), unsigned()) {
+            return ptr ? ptr->scheduler_rank.load(ptr->get_mutex()) : 0;
+        }
+        template<class SharedPtr>
+        static unsigned rank_of(const SharedPtr&, long) {
+            return 0;
+        }
+
+        // rank of node, which observe observables
+        template<class ...ObservablePtrs>
+        static unsigned rank(const ObservablePtrs&... observables) {
+            unsigned result = 0;
+            (void)std::initializer_list<int>{ (result = std::max(result, rank_of(observables, 0)), 0)... };
+            return result + 1;
+        }
+
+        // rank of node, which observe weak_ptrs (tuple - MultiObserver, vector - DynamicObserver)
+        template<class ...WeakPtrs>
+        static unsigned inputs_rank(const std::tuple<WeakPtrs...>& weak_ptrs) {
+            return MultiObserver::apply([](const auto&... weak_ptrs) {
+                return scheduler::rank(weak_ptrs.lock()...);
+            }, weak_ptrs);
+        }
+        template<class WeakPtr>
+        static unsigned inputs_rank(const std::vector<WeakPtr>& weak_ptrs) {
+            unsigned result = 1;
+            for (const auto& weak_ptr : weak_ptrs) {
+                result = std::max(result, scheduler::rank(weak_ptr.lock()));
+            }
+            return result;
+        }
+
+        // Rank::InputsRank for observer with observable_weak_ptrs
+        template<class Lock, class Observer>
+        static unsigned observer_inputs_rank(const void* observer, std::unique_lock<Lock>& l) {
+            const auto weak_ptrs = static_cast<const Observer*>(observer)->observable_weak_ptrs;
+            l.unlock();
+            return inputs_rank(weak_ptrs);
+        }
+    }
+    }
+
+
+    // Propagation scheduler.
+    // Deferred observers (observe_deferred, bind_deferred, ReactiveProperty::set_deferred) do not recompute on change,
+    // they only marked dirty. flush() recompute each dirty node once, in dependency order (by rank).
+    // Nodes made dirty during flush, recomputed in the same flush.
+    // Node, which inputs were re-set deeper since it was created, requeued with its live rank, not run early.
+    //
+    // flush(pool) recompute dirty nodes level by level: nodes of the same rank are independent,
+    // and run in parallel on pool. Next level starts when previous is done.
+    //
+    // Scheduler must outlive its nodes. flush() should not be called concurrently.
+    class Scheduler {
+        using Node = details::scheduler::Node;
+        using Lock = threading::SpinLock<threading::SpinLockMode::Adaptive>;
+        Lock lock;
+
+        struct RankGreater {
+            bool operator()(const std::shared_ptr<Node>& l, const std::shared_ptr<Node>& r) const {
+                return l->rank > r->rank;
+            }
+        };
+        std::priority_queue<std::shared_ptr<Node>, std::vector<std::shared_ptr<Node>>, RankGreater> dirty_nodes;
+
+    public:
+        Scheduler() {}
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        void mark_dirty(std::shared_ptr<Node>&& node) {
+            if (node->dirty.exchange(true)) return;     // already queued
+
+            std::unique_lock<Lock> l(lock);
+            dirty_nodes.emplace(std::move(node));
+        }
+
+        bool empty() {
+            std::unique_lock<Lock> l(lock);
+            return dirty_nodes.empty();
+        }
+
+        void flush() {
+            while (true) {
+                std::shared_ptr<Node> node;
+                {
+                    std::unique_lock<Lock> l(lock);
+                    if (dirty_nodes.empty()) return;
+
+                    node = dirty_nodes.top();
+                    dirty_nodes.pop();
+                }
+
+                const unsigned live_rank = node->live_rank();
+                if (live_rank > node->rank) {
+                    std::unique_lock<Lock> l(lock);
+                    node->rank = live_rank;
+                    dirty_nodes.emplace(std::move(node));
+                    continue;
+                }
+
+                // changes during run() will queue node again
+                node->dirty.store(false);
+                node->run();
+            }
+        }
+
+        // Closures must be thread safe, and observables must not be non_thread_safe.
+        void flush(threading::WorkStealingPool& pool) {
+            std::vector<std::shared_ptr<Node>> level;
+            while (true) {
+                level.clear();
+                {
+                    std::unique_lock<Lock> l(lock);
+                    if (dirty_nodes.empty()) return;
+
+                    const unsigned rank = dirty_nodes.top()->rank;
+                    while (!dirty_nodes.empty() && dirty_nodes.top()->rank == rank) {
+                        level.emplace_back(dirty_nodes.top());
+                        dirty_nodes.pop();
+                    }
+                }
+
+                // requeue stale ranked
+                std::size_t kept = 0;
+                for (auto& node : level) {
+                    const unsigned live_rank = node->live_rank();
+                    if (live_rank > node->rank) {
+                        std::unique_lock<Lock> l(lock);
+                        node->rank = live_rank;
+                        dirty_nodes.emplace(std::move(node));
+                    } else {
+                        level[kept++] = std::move(node);
+                    }
+                }
+                level.resize(kept);
+                if (level.empty()) continue;
+
+                for (const auto& node : level) {
+                    node->dirty.store(false);
+                }
+
+                if (level.size() == 1) {
+                    level.front()->run();
+                } else {
+                    pool.parallel_for(level.size(), [&](std::size_t i) {
+                        level[i]->run();
+                    });
+                }
+            }
+        }
+    };
+
+
+    namespace details{
+    namespace scheduler{
+
+        // Observer (alive while subscribed) holds node.
+        class MarkDirty {
+            Scheduler* scheduler;
+            std::shared_ptr<Node> node;
+        public:
+            MarkDirty(Scheduler& scheduler, const std::shared_ptr<Node>& node)
+                : scheduler(&scheduler)
+                , node(node) {}
+
+            template<class ...Args>
+            void operator()(Args&&...) const {
+                scheduler->mark_dirty(std::shared_ptr<Node>(node));
+            }
+        };
+
+        template<class ObserverPtr, class Closure>
+        class ObserverNode : public Node {
+        public:
+            weak_t<ObserverPtr> observer_weak;
+            Closure closure;
+
+            template<class ClosureT>
+            ObserverNode(unsigned rank, ClosureT&& closure)
+                : Node(rank)
+                , closure(std::forward<ClosureT>(closure)) {}
+
+            unsigned live_rank() override {
+                ObserverPtr observer = observer_weak.lock();
+                if (!observer) return 0;
+
+                return inputs_rank(observer->observable_weak_ptrs);
+            }
+
+            // Rank::InputsRank
+            template<class Lock>
+            static unsigned node_inputs_rank(const void* node, std::unique_lock<Lock>& l) {
+                ObserverPtr observer = static_cast<const ObserverNode*>(node)->observer_weak.lock();
+                l.unlock();
+                if (!observer) return 1;
+
+                return inputs_rank(observer->observable_weak_ptrs);
+            }
+
+            void run() override {
+                if (unsubscribed.load()) return;
+
+                ObserverPtr observer = observer_weak.lock();
+                if (!observer) return;
+
+                observer->execute(closure);
+            }
+
+            void unsubscribe() override {
+                unsubscribed.store(true);
+
+                ObserverPtr observer = observer_weak.lock();
+                if (!observer) return;
+
+                observer->unsubscribe();
+            }
+        };
+
+        template<class blocking_mode = reactive::default_blocking, bool add_unsubscibe_self = false, class Closure, class ...ObservablePtrs>
+        auto observe_impl(Scheduler& scheduler, unsigned rank, Closure&& closure, const ObservablePtrs&... observables) {
+            using ObserverPtr = decltype(
+                MultiObserver::observe_impl<blocking_mode, add_unsubscibe_self>(std::declval<MarkDirty>(), observables...)
+            );
+            using ObserverNode = ObserverNode<ObserverPtr, std::decay_t<Closure>>;
+
+            std::shared_ptr<ObserverNode> node = std::make_shared<ObserverNode>(rank, std::forward<Closure>(closure));
+            node->observer_weak = MultiObserver::observe_impl<blocking_mode, add_unsubscibe_self>(MarkDirty{scheduler, node}, observables...);
+
+            return node;
+        }
+    }
+    }
+
+
+    template<class blocking_mode = default_blocking, class Closure, class ...Observables>
+    Subscription observe_deferred(Scheduler& scheduler, Closure&& closure, const Observables&... observables){
+        return [
+            node = details::scheduler::observe_impl<blocking_mode>(
+                scheduler, details::scheduler::rank(observables.shared_ptr()...)
+                , std::forward<Closure>(closure), observables.shared_ptr()...)
+        ](){
+            node->unsubscribe();
+        };
+    }
+
+}
+
+#endif //REACTIVE_SCHEDULER_H
@@ -0,0 +1,174 @@
+#ifndef REACTIVE_SUBSCRIPTION_H
+#define REACTIVE_SUBSCRIPTION_H
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+namespace reactive{
+
+    // Type-erased unsubscriber. Returned by observe / bind, held by ReactiveProperty.
+    // Callable which fit inline storage (shared_ptr to observer) stored without allocation,
+    // bigger ones - on heap. Copyable, movable. Moved-from Subscription is empty; calling empty one does nothing.
+    class Subscription {
+        using Storage = std::aligned_storage_t<2 * sizeof(void*), alignof(void*)>;
+
+        struct VTable {
+            void (*call)(const Storage&);
+            void (*copy)(const Storage& from, Storage& to);
+            void (*move)(Storage& from, Storage& to);
+            void (*destroy)(Storage&);
+        };
+
+        template<class F>
+        using is_inline = std::integral_constant<bool,
+            sizeof(F) <= sizeof(Storage)
+            && alignof(Storage) % alignof(F) == 0
+            && std::is_nothrow_move_constructible<F>::value
+        >;
+
+        template<class F>
+        struct InlineOps {
+            static const F& get(const Storage& storage) {
+                return *reinterpret_cast<const F*>(&storage);
+            }
+            static F& get(Storage& storage) {
+                return *reinterpret_cast<F*>(&storage);
+            }
+
+            static void call(const Storage& storage) {
+                get(storage)();
+            }
+            static void copy(const Storage& from, Storage& to) {
+                new (&to) F(get(from));
+            }
+            static void move(Storage& from, Storage& to) {
+                new (&to) F(std::move(get(from)));
+                get(from).~F();
+            }
+            static void destroy(Storage& storage) {
+                get(storage).~F();
+            }
+            template<class ...Args>
+            static void create(Storage& storage, Args&&...args) {
+                new (&storage) F(std::forward<Args>(args)...);
+            }
+            static F* target(Storage& storage) {
+                return &get(storage);
+            }
+        };
+
+        template<class F>
+        struct HeapOps {
+            static F* get(const Storage& storage) {
+                return *reinterpret_cast<F* const*>(&storage);
+            }
+
+            static void call(const Storage& storage) {
+                (*get(storage))();
+            }
+            static void copy(const Storage& from, Storage& to) {
+                new (&to) F*(new F(*get(from)));
+            }
+            static void move(Storage& from, Storage& to) {
+                new (&to) F*(get(from));
+            }
+            static void destroy(Storage& storage) {
+                delete get(storage);
+            }
+            template<class ...Args>
+            static void create(Storage& storage, Args&&...args) {
+                new (&storage) F*(new F(std::forward<Args>(args)...));
+            }
+            static F* target(Storage& storage) {
+                return get(storage);
+            }
+        };
+
+        template<class F>
+        using Ops = std::conditional_t<is_inline<F>::value, InlineOps<F>, HeapOps<F>>;
+
+        template<class F>
+        static const VTable* vtable_of() {
+            static const VTable vtable{ &Ops<F>::call, &Ops<F>::copy, &Ops<F>::move, &Ops<F>::destroy };
+            return &vtable;
+        }
+
+        const VTable* vtable = nullptr;
+        Storage storage;
+
+    public:
+        Subscription() noexcept {}
+        Subscription(std::nullptr_t) noexcept {}
+
+        template<class F, class = std::enable_if_t< !std::is_same<std::decay_t<F>, Subscription>::value >>
+        Subscription(F&& f) {
+            using T = std::decay_t<F>;
+            Ops<T>::create(storage, std::forward<F>(f));
+            vtable = vtable_of<T>();
+        }
+
+        Subscription(const Subscription& other)
+            : vtable(other.vtable)
+        {
+            if (vtable) vtable->copy(other.storage, storage);
+        }
+        Subscription(Subscription&& other) noexcept
+            : vtable(other.vtable)
+        {
+            if (!vtable) return;
+            vtable->move(other.storage, storage);
+            other.vtable = nullptr;
+        }
+
+        Subscription& operator=(const Subscription& other) {
+            if (this == &other) return *this;
+            return *this = Subscription(other);
+        }
+        Subscription& operator=(Subscription&& other) noexcept {
+            if (this == &other) return *this;
+            reset();
+            if (!other.vtable) return *this;
+
+            other.vtable->move(other.storage, storage);
+            vtable = other.vtable;
+            other.vtable = nullptr;
+            return *this;
+        }
+        Subscription& operator=(std::nullptr_t) noexcept {
+            reset();
+            return *this;
+        }
+
+        ~Subscription() {
+            reset();
+        }
+
+        void reset() noexcept {
+            if (!vtable) return;
+            vtable->destroy(storage);
+            vtable = nullptr;
+        }
+
+        // unsubscribe
+        void operator()() const {
+            if (!vtable) return;
+            vtable->call(storage);
+        }
+
+        explicit operator bool() const noexcept {
+            return vtable != nullptr;
+        }
+
+        // stored callable, if it is F
+        template<class F>
+        F* target() noexcept {
+            if (vtable != vtable_of<F>()) return nullptr;
+            return Ops<F>::target(storage);
+        }
+    };
+
+}
+
+#endif //REACTIVE_SUBSCRIPTION_H
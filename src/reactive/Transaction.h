@@ -0,0 +1,42 @@
+#ifndef REACTIVE_TRANSACTION_H
+#define REACTIVE_TRANSACTION_H
+
+#include "details/Transaction.h"
+
+namespace reactive {
+
+	// Coalesce notifications of current thread writes.
+	// Writes are NOT buffered: inside scope values are stored immediately (visible to readers, including other
+	// threads, before commit, and not rolled back on exception) - only property events are deferred.
+	// Property destroyed inside scope on the same thread - its pending event dropped.
+	// On commit (or destruction), each changed property fires event once, with its latest value;
+	// observers (ReactiveProperty, observe) triggered by them executed once, after pending events delivered.
+	// Exception from handler: commit() rethrows it (rest of pending notifications dropped);
+	// destructor drops it too, and swallows exception.
+	// Nested transactions merged into outermost. Properties destroyed by other threads must outlive transaction.
+	class Transaction {
+		bool active = true;
+	public:
+		Transaction() {
+			details::TransactionState::begin();
+		}
+
+		Transaction(const Transaction&) = delete;
+		Transaction& operator=(const Transaction&) = delete;
+
+		void commit() {
+			if (!active) return;
+			active = false;
+			details::TransactionState::end();
+		}
+
+		~Transaction() {
+			try {
+				commit();
+			} catch (...) {}
+		}
+	};
+
+}
+
+#endif //REACTIVE_TRANSACTION_H
@@ -3,12 +3,13 @@
 
 #include <memory>
 #include "observer.h"
+#include "Scheduler.h"
 
 namespace reactive {
 
 	namespace details {
 		template<class blocking_mode, class Obj, class Closure, class ...Observables>
-		auto bind(const std::shared_ptr<Obj>& obj, Closure&& closure, const Observables&... observables) {
+		Subscription bind(const std::shared_ptr<Obj>& obj, Closure&& closure, const Observables&... observables) {
 			auto observer = /*details::*/MultiObserver::observe_w_unsubscribe_impl<blocking_mode>(
 				[
 					closure = std::forward<Closure>(closure)
@@ -32,7 +33,7 @@ namespace reactive {
 
 
 	template<class blocking_mode = default_blocking, class Obj, class Closure, class ...Observables>
-	auto bind(const std::shared_ptr<Obj>& obj, Closure&& closure, const Observables&... observables) {
+	Subscription bind(const std::shared_ptr<Obj>& obj, Closure&& closure, const Observables&... observables) {
 		return details::bind<blocking_mode>(obj,
 			[closure = std::forward<Closure>(closure)](auto&& unsubscribe_self, auto&&...args) {
 				closure(std::forward<decltype(args)>(args)...);
@@ -42,10 +43,34 @@ namespace reactive {
 	}
 	
 	template<class blocking_mode = default_blocking, class Obj, class Closure, class ...Observables>
-	auto bind_w_unsubscribe(const std::shared_ptr<Obj>& obj, Closure&& closure, const Observables&... observables) {
+	Subscription bind_w_unsubscribe(const std::shared_ptr<Obj>& obj, Closure&& closure, const Observables&... observables) {
 		return details::bind<blocking_mode>(obj, std::forward<Closure>(closure), observables...);
 	}
 
+	// Same as bind, but closure called only on scheduler.flush(), once per flush. See Scheduler.
+	template<class blocking_mode = default_blocking, class Obj, class Closure, class ...Observables>
+	Subscription bind_deferred(Scheduler& scheduler, const std::shared_ptr<Obj>& obj, Closure&& closure, const Observables&... observables) {
+		auto node = details::scheduler::observe_impl<blocking_mode, true>(
+			scheduler, details::scheduler::rank(observables.shared_ptr()...),
+			[
+				closure = std::forward<Closure>(closure)
+				, obj_weak = std::weak_ptr<Obj>(obj)
+			](auto&& unsubscribe_self, auto&&...args){
+				auto obj_ptr = obj_weak.lock();
+				if (!obj_ptr) {
+					unsubscribe_self();
+					return;
+				}
+
+				closure(std::move(obj_ptr), std::forward<decltype(args)>(args)...);
+			}
+			, observables.shared_ptr()...);
+
+		node->run();
+
+		return [node]() { node->unsubscribe(); };
+	}
+
 }
 
 #endif //REACTIVE_BIND_H
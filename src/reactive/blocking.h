@@ -7,6 +7,7 @@ namespace reactive {
 	struct blocking {};
 	struct nonblocking {};
 	struct nonblocking_atomic {};
+	struct snapshot {};			// value stored as shared immutable snapshot, see Snapshot
 	struct default_blocking{};
 
 	namespace details{
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <ratio>
+#include <cstddef>
+#include <type_traits>
+
+#include "details/utils/BitwiseCompare.h"
+
+namespace reactive {
+
+	// Property change detection policy: on set, decides if value changed (and event should be triggered).
+	// WriteLock always triggers event.
+	// Custom policy - struct with static template<class T> bool changed(const T& old_value, const T& new_value).
+	namespace change_detection {
+
+		// always trigger event
+		struct always {
+			template<class T>
+			static bool changed(const T&, const T&) {
+				return true;
+			}
+		};
+
+		// O(1): do not look at contents, trigger event if new value refers to other object.
+		// Non-owning views with data() (string_view, span - trivially copyable) - compared by data() and size();
+		// smart / raw pointers - by pointee. Other T (owning vector, string, ...) - always.
+		struct identity {
+			template<class T>
+			static bool changed(const T& old_value, const T& new_value) {
+				return changed_impl(old_value, new_value, 0);
+			}
+		private:
+			template<class T>
+			static auto changed_impl(const T& old_value, const T& new_value, int)
+				-> std::enable_if_t<std::is_trivially_copyable<T>::value, decltype(old_value.data(), old_value.size(), bool())>
+			{
+				return old_value.data() != new_value.data() || old_value.size() != new_value.size();
+			}
+			template<class T>
+			static auto changed_impl(const T& old_value, const T& new_value, long)
+				-> decltype(old_value.get(), bool())
+			{
+				return old_value.get() != new_value.get();
+			}
+			template<class T>
+			static std::enable_if_t<std::is_pointer<T>::value, bool> changed_impl(const T& old_value, const T& new_value, long) {
+				return old_value != new_value;
+			}
+			template<class T>
+			static bool changed_impl(const T&, const T&, ...) {
+				return true;
+			}
+		};
+
+		// operator==, if T have one, otherwise always (default)
+		struct equal {};
+
+		// Compare hash of new value with hash of current value, computed on previous set.
+		// Hash of old value is stored - one pass over new value only, instead of comparison.
+		// Hash collision will suppress event. Not for nonblocking_atomic.
+		struct hash {};
+
+		// Trigger event if |new - last notified| > Epsilon. Compared with value of last event, not current value -
+		// slow ramp of sub-epsilon steps triggers event once it drifts by Epsilon.
+		// Lock-free state - nonblocking_atomic allowed.
+		template<class Epsilon = std::ratio<1, 1000000>>
+		struct epsilon {
+			template<class T>
+			static T value() {
+				return static_cast<T>(Epsilon::num) / static_cast<T>(Epsilon::den);
+			}
+		};
+
+		// Trivially copyable T (std::array<float, N>, POD structs): compare bytes (SIMD, see utils::bitwise).
+		// Padding bytes compared too; -0.0 != 0.0, same NaNs are equal.
+		struct bitwise {
+			template<class T>
+			static bool changed(const T& old_value, const T& new_value) {
+				static_assert(std::is_trivially_copyable<T>::value, "bitwise change detection require trivially copyable T");
+				return !utils::bitwise::equal(&old_value, &new_value, sizeof(T));
+			}
+		};
+
+		// [first, last) elements (value_type / array element / byte) changed by last set.
+		struct range {
+			std::size_t first;
+			std::size_t last;
+		};
+
+		// bitwise + property.changed_range() - range of last change (whole value after WriteLock).
+		// Read it from event handler (blocking - under property lock; otherwise - may be already overwritten).
+		// Not for nonblocking_atomic.
+		struct bitwise_range {};
+
+		// F{}(old_value, new_value) - true if changed
+		template<class F>
+		struct functor {
+			template<class T>
+			static bool changed(const T& old_value, const T& new_value) {
+				return F{}(old_value, new_value);
+			}
+		};
+
+	}
+
+}
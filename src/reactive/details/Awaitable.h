@@ -0,0 +1,247 @@
+#ifndef REACTIVE_DETAILS_AWAITABLE_H
+#define REACTIVE_DETAILS_AWAITABLE_H
+
+// C++20 coroutine interface: co_await x.next(), co_await x.until(pred), x.values().
+// Coroutine resumed right from the event - on the thread, which changed property / fired event.
+
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include "Delegate.h"
+#include "Snapshot.h"
+#include "threading/SpinLock.h"
+#include "utils/optional.hpp"
+
+namespace reactive{
+namespace details{
+namespace coroutine{
+
+	template<class ...Args>
+	using Values = std::tuple<std::decay_t<decltype(reactive::details::unwrap(std::declval<const Args&>()))>...>;
+
+	// 0 args - void, 1 arg - value, more - tuple
+	template<class ...Args>
+	auto unpack(Values<Args...>&& values) {
+		if constexpr (sizeof...(Args) == 0) {
+			return;
+		} else if constexpr (sizeof...(Args) == 1) {
+			return std::get<0>(std::move(values));
+		} else {
+			return std::move(values);
+		}
+	}
+
+	// One-shot. State allocated with awaiter - event may call us concurrently,
+	// after we unsubscribed, so subscription can't point into coroutine frame.
+	template<class Pred, class ...Args>
+	struct OnceState {
+		std::atomic<bool> done{false};
+		std::coroutine_handle<> handle;
+		nonstd::optional<Values<Args...>> values;
+		Pred pred;
+
+		OnceState(Pred pred)
+			: pred(std::move(pred)) {}
+
+		// true - if we took values
+		bool try_take(const Args&... args) {
+			if (!pred(reactive::details::unwrap(args)...)) return false;
+			if (done.load(std::memory_order_relaxed) || done.exchange(true)) return false;
+
+			values.emplace(reactive::details::unwrap(args)...);
+			return true;
+		}
+	};
+
+	struct Any {
+		template<class ...Args>
+		bool operator()(const Args&...) const {
+			return true;
+		}
+	};
+
+	// Source - shared_ptr to property, or pointer to event.
+	// check_current - property, current value may already satisfy pred.
+	template<class Source, bool check_current, class Pred, class ...Args>
+	class OnceAwaiter {
+		using State = OnceState<Pred, Args...>;
+
+		Source source;
+		std::shared_ptr<State> state;
+		DelegateTag tag;
+		bool subscribed = false;
+	public:
+		OnceAwaiter(const Source& source, Pred pred)
+			: source(source)
+			, state(std::make_shared<State>(std::move(pred))) {}
+
+		OnceAwaiter(OnceAwaiter&&) = default;
+		OnceAwaiter& operator=(OnceAwaiter&&) = delete;
+
+		// coroutine may be destroyed while suspended - late event must not resume it
+		~OnceAwaiter() {
+			if (!state || !subscribed) return;		// moved / done
+			state->done.store(true);
+			(*source) -= tag;
+		}
+
+		bool await_ready() {
+			if constexpr (check_current) {
+				return state->try_take(source->event_value());
+			} else {
+				return false;
+			}
+		}
+
+		bool await_suspend(std::coroutine_handle<> handle) {
+			// once subscribed, coroutine may be resumed (and awaiter destroyed) from other thread - use locals only
+			const Source source = this->source;
+			const DelegateTag tag = this->tag;
+			const std::shared_ptr<State> state = this->state;
+			state->handle = handle;
+			subscribed = true;
+
+			source->subscribe(tag, [state](const Args&... args) {
+				if (!state->try_take(args...)) return;
+				state->handle.resume();
+			});
+
+			if constexpr (check_current) {
+				// changed, between await_ready and subscribe
+				if (state->try_take(source->event_value())) {
+					(*source) -= tag;
+					return false;
+				}
+			}
+			return true;
+		}
+
+		auto await_resume() {
+			(*source) -= tag;
+			subscribed = false;
+			return unpack<Args...>(std::move(*state->values));
+		}
+	};
+
+
+	// Async generator, conflating: subscribed once, keeps only latest value,
+	// which was not taken yet. co_await values.next() - next value.
+	template<class Source, class ...Args>
+	class ValuesGenerator {
+		struct State {
+			using Lock = threading::SpinLock<threading::SpinLockMode::Adaptive>;
+			Lock lock;
+			std::coroutine_handle<> handle;
+			nonstd::optional<Values<Args...>> latest;
+		};
+
+		Source source;
+		std::shared_ptr<State> state;
+		DelegateTag tag;
+
+		class Awaiter {
+			std::shared_ptr<State> state;
+			std::coroutine_handle<> handle;
+		public:
+			Awaiter(const std::shared_ptr<State>& state)
+				: state(state) {}
+
+			Awaiter(Awaiter&&) = default;
+			Awaiter& operator=(Awaiter&&) = delete;
+
+			// coroutine may be destroyed while suspended - forget its handle
+			~Awaiter() {
+				if (!state || !handle) return;
+				std::unique_lock<typename State::Lock> l(state->lock);
+				if (state->handle == handle) state->handle = nullptr;
+			}
+
+			bool await_ready() {
+				std::unique_lock<typename State::Lock> l(state->lock);
+				return bool(state->latest);
+			}
+			bool await_suspend(std::coroutine_handle<> handle) {
+				std::unique_lock<typename State::Lock> l(state->lock);
+				if (state->latest) return false;
+				state->handle = handle;
+				this->handle = handle;
+				return true;
+			}
+			auto await_resume() {
+				std::unique_lock<typename State::Lock> l(state->lock);
+				Values<Args...> values = std::move(*state->latest);
+				state->latest.reset();
+				l.unlock();
+
+				return unpack<Args...>(std::move(values));
+			}
+		};
+	public:
+		ValuesGenerator(const Source& source)
+			: source(source)
+			, state(std::make_shared<State>())
+		{
+			source->subscribe(tag, [state = state](const Args&... args) {
+				std::unique_lock<typename State::Lock> l(state->lock);
+				state->latest.emplace(reactive::details::unwrap(args)...);
+
+				std::coroutine_handle<> handle = std::exchange(state->handle, nullptr);
+				l.unlock();
+
+				if (handle) handle.resume();
+			});
+		}
+
+		ValuesGenerator(ValuesGenerator&&) = default;
+		ValuesGenerator& operator=(ValuesGenerator&&) = delete;
+
+		~ValuesGenerator() {
+			if (!state) return;		// moved
+			(*source) -= tag;
+		}
+
+		// should not be awaited concurrently
+		Awaiter next() {
+			return { state };
+		}
+	};
+
+
+	// property (std / intrusive shared_ptr)
+	template<class PropertyPtr, class Pred, class Property = typename PropertyPtr::element_type>
+	auto until(const PropertyPtr& property, Pred&& pred) {
+		return OnceAwaiter<PropertyPtr, true, std::decay_t<Pred>, typename Property::EventValue>{ property, std::forward<Pred>(pred) };
+	}
+	template<class PropertyPtr, class Property = typename PropertyPtr::element_type>
+	auto next(const PropertyPtr& property) {
+		return OnceAwaiter<PropertyPtr, false, Any, typename Property::EventValue>{ property, Any{} };
+	}
+	template<class PropertyPtr, class Property = typename PropertyPtr::element_type>
+	auto values(const PropertyPtr& property) {
+		return ValuesGenerator<PropertyPtr, typename Property::EventValue>{ property };
+	}
+
+	// event
+	template<class ...Args, class Event>
+	auto next(Event* event) {
+		return OnceAwaiter<Event*, false, Any, Args...>{ event, Any{} };
+	}
+	template<class ...Args, class Event>
+	auto values(Event* event) {
+		return ValuesGenerator<Event*, Args...>{ event };
+	}
+
+}
+}
+}
+
+#endif
+
+#endif //REACTIVE_DETAILS_AWAITABLE_H
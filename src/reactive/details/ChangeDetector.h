@@ -0,0 +1,160 @@
+#ifndef REACTIVE_DETAILS_CHANGEDETECTOR_H
+#define REACTIVE_DETAILS_CHANGEDETECTOR_H
+
+#include <type_traits>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+#include <cmath>
+
+#include "../change_detection.h"
+
+namespace reactive {
+namespace details {
+
+	// equality from #https://stackoverflow.com/a/36360646
+	namespace details
+	{
+		template <typename T, typename R, typename = R>
+		struct equality : std::false_type {};
+
+		template <typename T, typename R>
+		struct equality<T,R,decltype(std::declval<T>()==std::declval<T>())>
+				: std::true_type {};
+	}
+	template<typename T, typename R = bool>
+	struct has_equal_op : details::equality<T, R> {};
+
+
+	// Base - derived from, to keep single inheritance chain (empty base optimisation, see Settings).
+	// changed() called under property lock (or for nonblocking_atomic - without lock).
+	// reset() - value changed without check (WriteLock, construction).
+	// atomic_safe - changed() may run concurrently (nonblocking_atomic).
+	template<class policy, class T, class Base>
+	class ChangeDetector : public Base {
+	protected:
+		static constexpr const bool stateful = false;
+		static constexpr const bool atomic_safe = true;
+
+		static bool changed(const T& old_value, const T& new_value) {
+			return policy::changed(old_value, new_value);
+		}
+		void reset(const T&) {}
+	};
+
+	template<class T, class Base>
+	class ChangeDetector<change_detection::equal, T, Base> : public Base {
+		static bool changed(const T& old_value, const T& new_value, std::true_type) {
+			return !(new_value == old_value);
+		}
+		static bool changed(const T& old_value, const T& new_value, std::false_type) {
+			return true;
+		}
+	protected:
+		static constexpr const bool stateful = false;
+		static constexpr const bool atomic_safe = true;
+
+		static bool changed(const T& old_value, const T& new_value) {
+			return changed(old_value, new_value, std::integral_constant<bool, has_equal_op<T>::value>{});
+		}
+		void reset(const T&) {}
+	};
+
+	template<class T, class Base>
+	class ChangeDetector<change_detection::hash, T, Base> : public Base {
+		std::size_t m_hash = 0;		// of current value
+	protected:
+		static constexpr const bool stateful = true;
+		static constexpr const bool atomic_safe = false;
+
+		bool changed(const T& old_value, const T& new_value) {
+			const std::size_t new_hash = std::hash<T>{}(new_value);
+			if (new_hash == m_hash) return false;
+			m_hash = new_hash;
+			return true;
+		}
+		void reset(const T& value) {
+			m_hash = std::hash<T>{}(value);
+		}
+	};
+
+	template<class Epsilon, class T, class Base>
+	class ChangeDetector<change_detection::epsilon<Epsilon>, T, Base> : public Base {
+		std::atomic<T> m_notified{};		// value of last event
+	protected:
+		static constexpr const bool stateful = true;
+		static constexpr const bool atomic_safe = true;
+
+		bool changed(const T&, const T& new_value) {
+			T notified = m_notified.load(std::memory_order_relaxed);
+			do {
+				if (!(std::abs(new_value - notified) > change_detection::epsilon<Epsilon>::template value<T>())) return false;
+			} while (!m_notified.compare_exchange_weak(notified, new_value, std::memory_order_relaxed));
+			return true;
+		}
+		void reset(const T& value) {
+			m_notified.store(value, std::memory_order_relaxed);
+		}
+	public:
+		ChangeDetector() = default;
+		ChangeDetector(const ChangeDetector& other)
+			: Base(), m_notified(other.m_notified.load()) {}
+		ChangeDetector(ChangeDetector&& other)
+			: Base(std::move(other)), m_notified(other.m_notified.load()) {}
+	};
+
+
+	// element of bitwise_range: T::value_type (std::array) / array element / byte
+	template<class T, class = void>
+	struct bitwise_element {
+		using type = std::conditional_t<std::is_array<T>::value, std::remove_all_extents_t<T>, unsigned char>;
+	};
+	template<class T>
+	struct bitwise_element<T, std::void_t<typename T::value_type>> {
+		using type = std::conditional_t<sizeof(T) % sizeof(typename T::value_type) == 0, typename T::value_type, unsigned char>;
+	};
+
+	template<class T, class Base>
+	class ChangeDetector<change_detection::bitwise_range, T, Base> : public Base {
+		static_assert(std::is_trivially_copyable<T>::value, "bitwise change detection require trivially copyable T");
+		static constexpr const std::size_t element_size = sizeof(typename bitwise_element<T>::type);
+		static constexpr const std::size_t size = sizeof(T) / element_size;
+
+		// first << 32 | last - read without lock
+		std::atomic<std::uint64_t> m_range{ size };
+
+		void store(std::size_t first, std::size_t last) {
+			m_range.store((std::uint64_t(first) << 32) | std::uint64_t(last), std::memory_order_relaxed);
+		}
+	protected:
+		static constexpr const bool stateful = true;
+		static constexpr const bool atomic_safe = false;
+
+		bool changed(const T& old_value, const T& new_value) {
+			const std::size_t first = utils::bitwise::first_mismatch(&old_value, &new_value, sizeof(T));
+			if (first == sizeof(T)) return false;
+			const std::size_t last = utils::bitwise::last_mismatch(&old_value, &new_value, sizeof(T));
+
+			store(first / element_size, (last + element_size - 1) / element_size);
+			return true;
+		}
+		void reset(const T&) {
+			store(0, size);
+		}
+	public:
+		ChangeDetector() = default;
+		ChangeDetector(const ChangeDetector& other)
+			: Base(), m_range(other.m_range.load()) {}
+		ChangeDetector(ChangeDetector&& other)
+			: Base(std::move(other)), m_range(other.m_range.load()) {}
+
+		change_detection::range changed_range() const {
+			const std::uint64_t range = m_range.load(std::memory_order_relaxed);
+			return { std::size_t(range >> 32), std::size_t(range & 0xFFFFFFFFu) };
+		}
+	};
+
+}
+}
+
+#endif //REACTIVE_DETAILS_CHANGEDETECTOR_H
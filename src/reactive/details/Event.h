@@ -9,6 +9,7 @@
 
 
 #include "Delegate.h"
+#include "Awaitable.h"
 
 #include "threading/SpinLock.h"
 #include "utils/DeferredForwardKeyContainer.h"
@@ -59,6 +60,17 @@ namespace details {
 		}
 
 
+#if defined(__cpp_impl_coroutine)
+		// co_await event.next() - arguments of next call (void / value / tuple). Event must outlive awaiter.
+		auto next() {
+			return coroutine::next<Args...>(this);
+		}
+		// conflating async generator: auto values = event.values(); co_await values.next()
+		auto values() {
+			return coroutine::values<Args...>(this);
+		}
+#endif
+
 		template<class ...Ts>
 		void operator()(Ts&&...ts) {
 			list.foreach_value([&](auto& delegate) {
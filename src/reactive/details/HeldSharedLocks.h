@@ -0,0 +1,34 @@
+#ifndef REACTIVE_DETAILS_HELDSHAREDLOCKS_H
+#define REACTIVE_DETAILS_HELDSHAREDLOCKS_H
+
+#include <vector>
+#include <algorithm>
+
+namespace reactive {
+namespace details {
+
+	// Blocking properties, which shared lock held by this thread while it calls observers
+	// (event of blocking property, blocking observer closure). See MultiObserver::OrderedSharedLock.
+	inline std::vector<const void*>& held_shared_locks() {
+		static thread_local std::vector<const void*> locks;
+		return locks;
+	}
+
+	inline bool is_shared_lock_held(const void* id) {
+		const auto& locks = held_shared_locks();
+		return std::find(locks.begin(), locks.end(), id) != locks.end();
+	}
+
+	struct HeldSharedLock {
+		HeldSharedLock(const void* id) {
+			held_shared_locks().push_back(id);
+		}
+		~HeldSharedLock() {
+			held_shared_locks().pop_back();
+		}
+	};
+
+}
+}
+
+#endif //REACTIVE_DETAILS_HELDSHAREDLOCKS_H
@@ -0,0 +1,84 @@
+#ifndef REACTIVE_DETAILS_LAZYEVENT_H
+#define REACTIVE_DETAILS_LAZYEVENT_H
+
+#include <atomic>
+#include <utility>
+
+#include "Event.h"
+
+namespace reactive {
+namespace details {
+
+	// ConfigurableEvent, allocated on first subscribe (published with CAS), alive till destruction.
+	// Not subscribed - one pointer; call - one null check.
+	template<
+		class ActionListLock,
+		class ListMutationLock,
+		class ...Args>
+	class LazyEvent {
+		using Event = ConfigurableEventBase<ActionListLock, ListMutationLock, Args...>;
+
+		std::atomic<Event*> m_event{ nullptr };
+
+		Event* get() const {
+			return m_event.load(std::memory_order_acquire);
+		}
+		Event& get_or_create() {
+			Event* event = get();
+			if (event) return *event;
+
+			Event* fresh = new Event();
+			if (m_event.compare_exchange_strong(event, fresh, std::memory_order_acq_rel)) return *fresh;
+
+			// someone else was first
+			delete fresh;
+			return *event;
+		}
+
+	public:
+		LazyEvent() = default;
+
+		// non thread safe
+		LazyEvent(LazyEvent&& other)
+			: m_event(other.m_event.exchange(nullptr)) {}
+		LazyEvent& operator=(LazyEvent&& other) {
+			delete m_event.exchange(other.m_event.exchange(nullptr));
+			return *this;
+		}
+
+		~LazyEvent() {
+			delete get();
+		}
+
+		// nobody ever subscribed
+		bool empty() const {
+			return get() == nullptr;
+		}
+
+		template<class Fn>
+		void subscribe(const DelegateTag& tag, Fn&& fn) {
+			get_or_create().subscribe(tag, std::forward<Fn>(fn));
+		}
+		template<class Delegate>
+		void subscribe(Delegate&& delegate) {
+			get_or_create().subscribe(std::forward<Delegate>(delegate));
+		}
+		template<class Closure>
+		void operator+=(Closure&& closure) {
+			get_or_create() += std::forward<Closure>(closure);
+		}
+		template<class Delegate>
+		void operator-=(Delegate&& delegate) {
+			if (Event* event = get()) *event -= std::forward<Delegate>(delegate);
+		}
+
+		template<class ...Ts>
+		void operator()(Ts&&...ts) {
+			if (Event* event = get()) (*event)(std::forward<Ts>(ts)...);
+		}
+	};
+
+}
+}
+
+#endif //REACTIVE_DETAILS_LAZYEVENT_H
@@ -0,0 +1,271 @@
+#ifndef REACTIVE_DETAILS_MAPVIEW_H
+#define REACTIVE_DETAILS_MAPVIEW_H
+
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+
+#include "threading/upgrade_mutex.h"
+#include "threading/SpinLock.h"
+#include "utils/OrderStatisticTree.h"
+#include "ObservableMap.h"
+#include "ObservableVector.h"
+#include "Event.h"
+
+namespace reactive {
+namespace details {
+
+	// Subscribe view to source bulk event, then sync with all source keys.
+	// View updated by re-reading current value of changed keys - order of concurrent notifications does not matter.
+	template<class View>
+	void connect_view(const std::shared_ptr<View>& view) {
+		using Source = typename View::Source;
+		using K      = typename View::Key;
+
+		std::weak_ptr<View> weak = view;
+		const Source* source = view->m_source.get();
+		view->m_source->subscribe(view->m_tag, [weak, source](const MapDiff<K>& diff) {
+			if (std::shared_ptr<View> view = weak.lock()) view->apply(*source, diff);
+		});
+
+		MapDiff<K> all;
+		source->foreach([&](const K& key, const auto&) {
+			all.push_back({ MapChange<K>::insert, key });
+		});
+		view->apply(*source, all);
+	}
+
+
+	// Keys of source, which value satisfies pred. Result stored in ObservableMap - chainable, with key subscriptions.
+	template<class K, class V, class Hash, std::size_t stripes, class Pred>
+	class FilteredMap {
+		template<class View>
+		friend void connect_view(const std::shared_ptr<View>&);
+	public:
+		using Key    = K;
+		using Source = ObservableMap<K, V, Hash, stripes>;
+	private:
+		std::shared_ptr<Source> m_source;		// keep alive chain of views
+		DelegateTag m_tag;
+		Pred m_pred;
+		std::mutex m_lock;					// apply's serialized, result bulk event in order
+		Source m_map;
+
+		void apply(const Source& source, const MapDiff<K>& diff) {
+			std::unique_lock<std::mutex> l(m_lock);
+			auto batch = m_map.batch();
+			for (const MapChange<K>& change : diff) {
+				nonstd::optional<V> value = source.get(change.key);
+				if (value && m_pred(*value)) {
+					batch.set(change.key, std::move(*value));
+				} else {
+					batch.erase(change.key);
+				}
+			}
+		}
+	public:
+		FilteredMap(std::shared_ptr<Source> source, Pred pred)
+			: m_source(std::move(source))
+			, m_pred(std::move(pred)) {}
+		FilteredMap(const FilteredMap&) = delete;
+
+		~FilteredMap() {
+			*m_source -= m_tag;
+		}
+
+		// returns result map, which keeps view alive
+		static std::shared_ptr<Source> make(std::shared_ptr<Source> source, Pred pred) {
+			auto view = std::make_shared<FilteredMap>(std::move(source), std::move(pred));
+			connect_view(view);
+			return { view, &view->m_map };
+		}
+	};
+
+
+	// Values of source, ordered by Less (ties - by key arrival), limited to first `limit`.
+	// Per change O(log n). Event: (const VectorDiff&, const Range&), rank based diff of visible window,
+	// called once per source notification, under shared lock.
+	template<class K, class V, class Hash, std::size_t stripes, class Less>
+	class SortedMap {
+		using Self = SortedMap;
+		using Lock = acme::upgrade_mutex;
+
+		template<class View>
+		friend void connect_view(const std::shared_ptr<View>&);
+	public:
+		using Key    = K;
+		using Source = ObservableMap<K, V, Hash, stripes>;
+		class Range;
+	private:
+		struct Slot {
+			V value;
+			std::uint64_t seq;
+		};
+		using Items = std::unordered_map<K, Slot, Hash>;
+		using Item  = typename Items::value_type;
+
+		struct ItemLess {
+			Less less;
+			bool operator()(const Item* l, const Item* r) const {
+				if (less(l->second.value, r->second.value)) return true;
+				if (less(r->second.value, l->second.value)) return false;
+				return l->second.seq < r->second.seq;
+			}
+		};
+
+		std::shared_ptr<Source> m_source;
+		DelegateTag m_tag;
+
+		mutable Lock m_lock;
+		Items m_items;								// node pointers stable - tree refers them
+		utils::OrderStatisticTree<const Item*, ItemLess> m_tree;
+		std::uint64_t m_seq = 0;
+		const std::size_t m_limit;
+		VectorDiff m_diff;							// of current apply, reused (under unique lock)
+		mutable ConfigurableEvent<threading::SpinLock<threading::SpinLockMode::Yield>, std::shared_mutex
+			, const VectorDiff&, const Range&> event;
+
+		// window [0, limit) changes
+		void inserted(std::size_t rank) {
+			if (rank >= m_limit) return;
+			record_change(m_diff, VectorChange::insert, rank, rank + 1);
+			if (m_tree.size() > m_limit) record_change(m_diff, VectorChange::erase, m_limit, m_limit + 1);
+		}
+		// size - of tree without erased item
+		void erased(std::size_t rank, std::size_t size) {
+			if (rank >= m_limit) return;
+			record_change(m_diff, VectorChange::erase, rank, rank + 1);
+			if (size >= m_limit) record_change(m_diff, VectorChange::insert, m_limit - 1, m_limit);
+		}
+		void updated(std::size_t rank) {
+			if (rank >= m_limit) return;
+			record_change(m_diff, VectorChange::update, rank, rank + 1);
+		}
+
+		void sync(const K& key, nonstd::optional<V>&& value) {
+			auto it = m_items.find(key);
+			if (!value) {
+				if (it == m_items.end()) return;
+				const std::size_t rank = m_tree.erase(&*it);
+				m_items.erase(it);
+				erased(rank, m_tree.size());
+				return;
+			}
+
+			if (it == m_items.end()) {
+				it = m_items.emplace(key, Slot{ std::move(*value), m_seq++ }).first;
+				inserted(m_tree.insert(&*it));
+				return;
+			}
+
+			const std::size_t old_rank = m_tree.erase(&*it);
+			it->second.value = std::move(*value);
+			const std::size_t new_rank = m_tree.insert(&*it);
+			if (old_rank == new_rank) {
+				updated(new_rank);
+			} else {
+				// as if erased, then inserted
+				erased(old_rank, m_tree.size() - 1);
+				inserted(new_rank);
+			}
+		}
+
+		void apply(const Source& source, const MapDiff<K>& diff) {
+			std::unique_lock<Lock> l(m_lock);
+			m_diff.clear();
+			for (const MapChange<K>& change : diff) {
+				sync(change.key, source.get(change.key));
+			}
+			if (m_diff.empty()) return;
+
+			std::shared_lock<Lock> sl(acme::upgrade_lock<Lock>(std::move(l)));
+			event(m_diff, Range{ this });
+		}
+
+	public:
+		// Visible window accessor, no locking.
+		class Range {
+			friend Self;
+			const Self* self;
+
+			Range(const Self* self)
+				: self(self) {}
+		public:
+			std::size_t size() const {
+				return std::min(self->m_tree.size(), self->m_limit);
+			}
+			const K& key(std::size_t i) const {
+				return self->m_tree[i]->first;
+			}
+			const V& value(std::size_t i) const {
+				return self->m_tree[i]->second.value;
+			}
+			// fn(const K&, const V&), in order
+			template<class Fn>
+			void foreach(Fn&& fn) const {
+				if (self->m_tree.size() <= self->m_limit) {
+					self->m_tree.foreach([&](const Item* item) { fn(item->first, item->second.value); });
+					return;
+				}
+				for (std::size_t i = 0; i < self->m_limit; ++i) fn(key(i), value(i));
+			}
+		};
+
+		class ReadLock : public Range {
+			friend Self;
+			std::shared_lock<Lock> lock;
+
+			ReadLock(const Self& self)
+				: Range(&self)
+				, lock(self.m_lock) {}
+		public:
+			ReadLock(ReadLock&&) = default;
+
+			void unlock() {
+				lock.unlock();
+			}
+		};
+
+		SortedMap(std::shared_ptr<Source> source, Less less, std::size_t limit)
+			: m_source(std::move(source))
+			, m_tree(ItemLess{ std::move(less) })
+			, m_limit(limit) {}
+		SortedMap(const SortedMap&) = delete;
+
+		~SortedMap() {
+			*m_source -= m_tag;
+		}
+
+		static std::shared_ptr<SortedMap> make(std::shared_ptr<Source> source, Less less, std::size_t limit) {
+			auto view = std::make_shared<SortedMap>(std::move(source), std::move(less), limit);
+			connect_view(view);
+			return view;
+		}
+
+		ReadLock lock() const {
+			return { *this };
+		}
+
+		// event control (non-blocking)
+		template<class DelegateT>
+		void operator+=(DelegateT&& closure) const {
+			event += std::forward<DelegateT>(closure);
+		}
+		template<class Fn>
+		void subscribe(const DelegateTag& tag, Fn&& fn) const {
+			event.subscribe(tag, std::forward<Fn>(fn));
+		}
+		template<class Delegate>
+		void operator-=(Delegate&& closure) const {
+			event -= std::forward<Delegate>(closure);
+		}
+	};
+
+}
+}
+
+#endif //REACTIVE_DETAILS_MAPVIEW_H
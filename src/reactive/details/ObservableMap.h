@@ -0,0 +1,305 @@
+#ifndef REACTIVE_DETAILS_OBSERVABLEMAP_H
+#define REACTIVE_DETAILS_OBSERVABLEMAP_H
+
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <functional>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+
+#include "threading/SpinLock.h"
+#include "utils/optional.hpp"
+#include "ChangeDetector.h"
+#include "Event.h"
+
+namespace reactive {
+
+	// Key set change of ObservableMap
+	template<class K>
+	struct MapChange {
+		enum Kind { insert, update, erase };
+
+		Kind kind;
+		K key;
+	};
+	template<class K>
+	using MapDiff = std::vector<MapChange<K>>;
+
+namespace details {
+
+	// thread-safe, non-blocking.
+	// Lock striped hash table: stripes count of unordered_maps, each with own SpinLock.
+	// Key subscribers list created on first subscribe to key, destroyed with last unsubscribe.
+	// Events called without locks (concurrent writes of one key may notify out of order):
+	// key event - (const K& key, const V* value) nullptr if erased; bulk event - (const MapDiff<K>&), once per batch.
+	template<class K, class V, class Hash = std::hash<K>, std::size_t stripes = 64>
+	class ObservableMap {
+		static_assert((stripes & (stripes - 1)) == 0, "stripes must be power of 2");
+
+		using Lock = threading::SpinLock<threading::SpinLockMode::Adaptive>;
+		using KeyEvent = ConfigurableEvent<threading::SpinLock<threading::SpinLockMode::Yield>, std::shared_mutex, const K&, const V*>;
+
+		struct KeySubscribers {
+			KeyEvent event;
+			std::vector<DelegateTag> tags;		// subscribed - list dropped when last one leaves
+		};
+		struct Node {
+			nonstd::optional<V> value;
+			std::shared_ptr<KeySubscribers> subscribers;		// lazy
+		};
+
+		struct alignas(64) Stripe {
+			mutable Lock lock;
+			std::unordered_map<K, Node, Hash> nodes;
+			std::size_t size = 0;		// nodes with value
+		};
+
+		Hash m_hash;
+		std::array<Stripe, stripes> m_stripes;
+		mutable ConfigurableEvent<threading::SpinLock<threading::SpinLockMode::Yield>, std::shared_mutex, const MapDiff<K>&> m_event;
+
+		Stripe& stripe(const K& key) {
+			// mixed upper bits - unordered_map use lower ones
+			const std::uint64_t hash = std::uint64_t(m_hash(key)) * 0x9E3779B97F4A7C15ull;
+			return m_stripes[(hash >> 40) & (stripes - 1)];
+		}
+		const Stripe& stripe(const K& key) const {
+			return const_cast<ObservableMap*>(this)->stripe(key);
+		}
+
+		static void erase_if_unused(Stripe& stripe, typename std::unordered_map<K, Node, Hash>::iterator it) {
+			if (!it->second.value && !it->second.subscribers) stripe.nodes.erase(it);
+		}
+
+		// unlock, call key event - if someone subscribed (value copied under lock)
+		static void notify_key(std::unique_lock<Lock>& lock, const Node& node, const K& key) {
+			if (!node.subscribers) {
+				lock.unlock();
+				return;
+			}
+			std::shared_ptr<KeySubscribers> subscribers = node.subscribers;
+			nonstd::optional<V> value = node.value;
+			lock.unlock();
+
+			subscribers->event(key, value ? &*value : nullptr);
+		}
+
+		static bool equal(const V& l, const V& r, std::true_type) {
+			return l == r;
+		}
+		static bool equal(const V&, const V&, std::false_type) {
+			return false;
+		}
+
+	public:
+		class Batch;
+
+	private:
+		// nullptr batch - single change, bulk event right away
+		template<class Value>
+		void set_impl(const K& key, Value&& value, Batch* batch) {
+			Stripe& s = stripe(key);
+			std::unique_lock<Lock> l(s.lock);
+			Node& node = s.nodes[key];
+
+			typename MapChange<K>::Kind kind;
+			if (node.value) {
+				if (equal(*node.value, value, std::integral_constant<bool, has_equal_op<V>::value>{})) return;
+				*node.value = std::forward<Value>(value);
+				kind = MapChange<K>::update;
+			} else {
+				node.value.emplace(std::forward<Value>(value));
+				s.size++;
+				kind = MapChange<K>::insert;
+			}
+
+			notify_key(l, node, key);
+			changed(batch, kind, key);
+		}
+
+		bool erase_impl(const K& key, Batch* batch) {
+			Stripe& s = stripe(key);
+			std::unique_lock<Lock> l(s.lock);
+			auto it = s.nodes.find(key);
+			if (it == s.nodes.end() || !it->second.value) return false;
+
+			it->second.value.reset();
+			s.size--;
+			std::shared_ptr<KeySubscribers> subscribers = it->second.subscribers;
+			erase_if_unused(s, it);
+			l.unlock();
+
+			if (subscribers) subscribers->event(key, nullptr);
+			changed(batch, MapChange<K>::erase, key);
+			return true;
+		}
+
+		// fn(V&) on existing value
+		template<class Fn>
+		bool update_impl(const K& key, Fn&& fn, Batch* batch) {
+			Stripe& s = stripe(key);
+			std::unique_lock<Lock> l(s.lock);
+			auto it = s.nodes.find(key);
+			if (it == s.nodes.end() || !it->second.value) return false;
+
+			fn(*it->second.value);
+			notify_key(l, it->second, key);
+			changed(batch, MapChange<K>::update, key);
+			return true;
+		}
+
+		void changed(Batch* batch, typename MapChange<K>::Kind kind, const K& key) {
+			if (batch) {
+				batch->m_diff.push_back({ kind, key });
+				return;
+			}
+			const MapDiff<K> diff{ { kind, key } };
+			m_event(diff);
+		}
+
+	public:
+		ObservableMap() {}
+		ObservableMap(const ObservableMap&) = delete;
+
+		// Changes applied immediately, key events triggered immediately, bulk event - once, on destruction.
+		class Batch {
+			friend ObservableMap;
+			ObservableMap* self;
+			MapDiff<K> m_diff;
+
+			Batch(ObservableMap& self)
+				: self(&self) {}
+		public:
+			Batch(Batch&& other)
+				: self(other.self)
+				, m_diff(std::move(other.m_diff))
+			{
+				other.self = nullptr;
+			}
+			Batch(const Batch&) = delete;
+
+			template<class Value>
+			void set(const K& key, Value&& value) {
+				self->set_impl(key, std::forward<Value>(value), this);
+			}
+			bool erase(const K& key) {
+				return self->erase_impl(key, this);
+			}
+			template<class Fn>
+			bool update(const K& key, Fn&& fn) {
+				return self->update_impl(key, std::forward<Fn>(fn), this);
+			}
+
+			void commit() {
+				if (!self) return;
+				if (!m_diff.empty()) self->m_event(m_diff);
+				self = nullptr;
+			}
+			~Batch() {
+				commit();
+			}
+		};
+		Batch batch() {
+			return { *this };
+		}
+
+		// mutators
+		template<class Value>
+		void set(const K& key, Value&& value) {
+			set_impl(key, std::forward<Value>(value), nullptr);
+		}
+		bool erase(const K& key) {
+			return erase_impl(key, nullptr);
+		}
+		template<class Fn>
+		bool update(const K& key, Fn&& fn) {
+			return update_impl(key, std::forward<Fn>(fn), nullptr);
+		}
+
+		// accessors
+		nonstd::optional<V> get(const K& key) const {
+			const Stripe& s = stripe(key);
+			std::unique_lock<Lock> l(s.lock);
+			auto it = s.nodes.find(key);
+			if (it == s.nodes.end()) return {};
+			return it->second.value;
+		}
+		bool contains(const K& key) const {
+			const Stripe& s = stripe(key);
+			std::unique_lock<Lock> l(s.lock);
+			auto it = s.nodes.find(key);
+			return it != s.nodes.end() && it->second.value;
+		}
+		// sum of stripe sizes, each taken under own lock
+		std::size_t size() const {
+			std::size_t size = 0;
+			for (const Stripe& s : m_stripes) {
+				std::unique_lock<Lock> l(s.lock);
+				size += s.size;
+			}
+			return size;
+		}
+		// fn(const K&, const V&), stripe by stripe, under stripe lock - should not modify map
+		template<class Fn>
+		void foreach(Fn&& fn) const {
+			for (const Stripe& s : m_stripes) {
+				std::unique_lock<Lock> l(s.lock);
+				for (const auto& key_node : s.nodes) {
+					if (key_node.second.value) fn(key_node.first, *key_node.second.value);
+				}
+			}
+		}
+
+		// key subscription
+		template<class Fn>
+		void subscribe(const K& key, const DelegateTag& tag, Fn&& fn) {
+			Stripe& s = stripe(key);
+			std::unique_lock<Lock> l(s.lock);
+			Node& node = s.nodes[key];
+			if (!node.subscribers) node.subscribers = std::make_shared<KeySubscribers>();
+			node.subscribers->tags.push_back(tag);
+			node.subscribers->event.subscribe(tag, std::forward<Fn>(fn));
+		}
+		void unsubscribe(const K& key, const DelegateTag& tag) {
+			Stripe& s = stripe(key);
+			std::unique_lock<Lock> l(s.lock);
+			auto it = s.nodes.find(key);
+			if (it == s.nodes.end() || !it->second.subscribers) return;
+
+			std::shared_ptr<KeySubscribers>& subscribers = it->second.subscribers;
+			std::vector<DelegateTag>& tags = subscribers->tags;
+			const auto removed = std::remove(tags.begin(), tags.end(), tag);
+			if (removed == tags.end()) return;		// not subscribed to this key
+			tags.erase(removed, tags.end());
+
+			subscribers->event -= tag;
+			if (tags.empty()) {
+				subscribers.reset();
+				erase_if_unused(s, it);
+			}
+		}
+
+		// bulk event control (non-blocking)
+		template<class DelegateT>
+		void operator+=(DelegateT&& closure) const {
+			m_event += std::forward<DelegateT>(closure);
+		}
+		template<class Fn>
+		void subscribe(const DelegateTag& tag, Fn&& fn) const {
+			m_event.subscribe(tag, std::forward<Fn>(fn));
+		}
+		template<class Delegate>
+		void operator-=(Delegate&& closure) const {
+			m_event -= std::forward<Delegate>(closure);
+		}
+	};
+
+}
+}
+
+#endif //REACTIVE_DETAILS_OBSERVABLEMAP_H
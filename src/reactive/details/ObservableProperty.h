@@ -3,24 +3,18 @@
 
 #include "threading/upgrade_mutex.h"
 #include "Event.h"
+#include "LazyEvent.h"
+#include "Snapshot.h"
+#include "HeldSharedLocks.h"
+#include "ChangeDetector.h"
+#include "threading/AtomicWait.h"
+#include "Transaction.h"
 
 #include "../blocking.h"
 
 namespace reactive {
 namespace details {
 
-	// equality from #https://stackoverflow.com/a/36360646
-	namespace details
-	{
-		template <typename T, typename R, typename = R>
-		struct equality : std::false_type {};
-
-		template <typename T, typename R>
-		struct equality<T,R,decltype(std::declval<T>()==std::declval<T>())>
-				: std::true_type {};
-	}
-	template<typename T, typename R = bool>
-	struct has_equal_op : details::equality<T, R> {};
 
 	namespace details {
 		// ObservableProperty Does not inherit Settings, just because of non working VS 2017 "Empty base optimization"
@@ -32,6 +26,7 @@ namespace details {
 
 			static const constexpr bool do_blocking  = std::is_same<blocking_mode, blocking>::value;
 			static const constexpr bool atomic_value = std::is_same<blocking_mode, nonblocking_atomic>::value;
+			static const constexpr bool snapshot_value = std::is_same<blocking_mode, snapshot>::value;
 
 			using Lock = std::conditional_t<do_blocking
 				, acme::upgrade_mutex
@@ -60,16 +55,20 @@ namespace details {
 	// thread-safe
 	// reactive::nonblocking =  value will be copied twice on set
 	//                          safe to change value right from the observer (may cause infinite loop)
+	// reactive::snapshot    =  value stored as shared_ptr<const T>, one allocation per set,
+	//                          observers receive Snapshot<T> - no copies of T
 	template<class T, class blocking_class = reactive::default_blocking, class friend_class = std::true_type
 		, class ObservablePropertyLock_mutex = typename details::Settings<T, blocking_class>::Lock
 		, class EvenActionListLock = threading::SpinLock<threading::SpinLockMode::Yield>
 		, class EventMutationListLock = std::shared_mutex
+		, class change_detection_policy = reactive::change_detection::equal
 	>
 	class ObservablePropertyConfigurable
-		: public details::ObservablePropertyLock< ObservablePropertyLock_mutex >
+		: public reactive::details::ChangeDetector< change_detection_policy, T, details::ObservablePropertyLock< ObservablePropertyLock_mutex > >
 	{
 		friend friend_class;
-		using Self = ObservablePropertyConfigurable<T, blocking_class, friend_class, ObservablePropertyLock_mutex, EvenActionListLock, EventMutationListLock>;
+		using Self = ObservablePropertyConfigurable<T, blocking_class, friend_class, ObservablePropertyLock_mutex, EvenActionListLock, EventMutationListLock, change_detection_policy>;
+		using ChangeDetector = reactive::details::ChangeDetector< change_detection_policy, T, details::ObservablePropertyLock< ObservablePropertyLock_mutex > >;
 
 
 		using Settings = details::Settings<T, blocking_class>;
@@ -86,20 +85,29 @@ namespace details {
 	protected:
 		static const constexpr bool do_blocking = Settings::do_blocking;
 		static const constexpr bool atomic_value = Settings::atomic_value;
+		static const constexpr bool snapshot_value = Settings::snapshot_value;
 		using Lock = ObservablePropertyLock_mutex;
 
+		static_assert(!(atomic_value && !ChangeDetector::atomic_safe), "Stateful change detection (hash, bitwise_range) require lock - use other than nonblocking_atomic blocking mode.");
+
 		using BaseLock::m_lock;
 
 	public:
 		using Value = T;
+		using EventValue = std::conditional_t<snapshot_value, Snapshot<T>, T>;		// event argument
 
 	protected:
 		// variables order matters (for smaller object size)
-		std::conditional_t<atomic_value, std::atomic<T>, T> value;
-		mutable ConfigurableEvent<EvenActionListLock, EventMutationListLock, const T&> event;
+		std::conditional_t<atomic_value, std::atomic<T>
+			, std::conditional_t<snapshot_value, reactive::details::SnapshotStorage<T>, T>
+		> value;
+		mutable LazyEvent<EvenActionListLock, EventMutationListLock, const EventValue&> event;		// allocated on first subscribe
+		threading::VersionWord m_version;		// bumped on each write, waited by wait_for_change
 
 	public:
-		ObservablePropertyConfigurable() {}
+		ObservablePropertyConfigurable() {
+			reset_change_detector();
+		}
 
 		// in place construction
 		template<
@@ -107,7 +115,10 @@ namespace details {
 			, class = typename std::enable_if_t< !atomic_value && !std::is_same< std::decay_t<Arg>, Self >::value >
 		>
 		ObservablePropertyConfigurable(Arg&& arg, Args&&...args)
-			: value( std::forward<Arg>(arg), std::forward<Args>(args)... ) {};
+			: value( std::forward<Arg>(arg), std::forward<Args>(args)... )
+		{
+			reset_change_detector();
+		}
 
 		// for atomic
 		template<
@@ -116,12 +127,23 @@ namespace details {
 			, typename = void
 		>
 		ObservablePropertyConfigurable(Arg&& arg, Args&&...args)
-			: value( T(std::forward<Arg>(arg), std::forward<Args>(args)...) ) {};
+			: value( T(std::forward<Arg>(arg), std::forward<Args>(args)...) )
+		{
+			reset_change_detector();
+		}
+
+		// pending Transaction event of this thread
+		~ObservablePropertyConfigurable() {
+			reactive::details::TransactionState::forget_event(this);
+		}
 
 
 		// do not copy event list
 		ObservablePropertyConfigurable(const ObservablePropertyConfigurable& other)
-			:value(other.getCopy()) {}
+			:value(other.getCopy())
+		{
+			reset_change_detector();
+		}
 		ObservablePropertyConfigurable& operator=(const ObservablePropertyConfigurable& other) {
 			set_value(other.getCopy());
 			return *this;
@@ -151,15 +173,35 @@ namespace details {
 		}
 
 	private:
-		static bool need_trigger_event(const T& old_value, const T& new_value, std::true_type) {
-			return !(new_value == old_value);
+		const T& get_value(std::true_type snapshot_value) const {
+			return *value.ptr;
 		}
-		static bool need_trigger_event(const T& old_value, const T& new_value, std::false_type) {
-			return true;
+		const T& get_value(std::false_type snapshot_value) const {
+			return value;
+		}
+		// non-atomic value (under lock)
+		const T& get_value() const {
+			return get_value(std::integral_constant<bool, snapshot_value>{});
+		}
+
+		// value changed without check (under lock)
+		void reset_change_detector(std::true_type stateful, std::true_type atomic) {
+			this->reset(this->value.load());
+		}
+		void reset_change_detector(std::true_type stateful, std::false_type atomic) {
+			this->reset(get_value());
+		}
+		void reset_change_detector(std::true_type stateful) {
+			reset_change_detector(stateful, std::integral_constant<bool, atomic_value>{});
+		}
+		void reset_change_detector(std::false_type stateful) {}
+		void reset_change_detector() {
+			reset_change_detector(std::integral_constant<bool, ChangeDetector::stateful>{});
 		}
 	protected:
-		static bool need_trigger_event(const T& old_value, const T& new_value) {
-			return need_trigger_event(old_value, new_value, std::integral_constant<bool, has_equal_op<T>::value >{});
+		// see change_detection_policy
+		bool need_trigger_event(const T& old_value, const T& new_value) {
+			return ChangeDetector::changed(old_value, new_value);
 		}
 
 		template<class Any>
@@ -171,19 +213,31 @@ namespace details {
 	private:
 		template<class Any, class AnyLock>
 		void set_value_impl(Any&& any, std::unique_lock<AnyLock>&& lock, std::true_type do_block) {
-			const bool need_event = need_trigger_event(any, this->value);
+			const bool need_event = need_trigger_event(this->value, any);
 
 			//std::unique_lock<Lock> l(lock);
 				this->value = std::forward<Any>(any);
 
 			if (!need_event) return;
+			m_version.bump();
+			if (event.empty()) return;
+			if (defer_event()) return;
 
 			std::shared_lock<AnyLock> sl(acme::upgrade_lock<AnyLock>(std::move(lock)));
+			HeldSharedLock held(shared_lock_id());
 				event(this->value);
 		}
 		template<class Any, class AnyLock>
 		void set_value_impl(Any&& any, std::unique_lock<AnyLock>&& lock, std::false_type do_block) {
-			const bool need_event = need_trigger_event(any, this->value);
+			const bool need_event = need_trigger_event(this->value, any);
+
+			// nobody listens - no temporary copy
+			if (!need_event || event.empty()) {
+				this->value = std::forward<Any>(any);
+				lock.unlock();
+				if (need_event) m_version.bump();
+				return;
+			}
 
 			//lock.lock();
 				const T temp_value = any;
@@ -191,12 +245,37 @@ namespace details {
 			lock.unlock();
 
 			if (!need_event) return;
+			m_version.bump();
+			if (defer_event()) return;
 				event(temp_value);
 		}
+		template<class Any, class AnyLock>
+		void set_value_snapshot(Any&& any, std::unique_lock<AnyLock>&& lock) {
+			std::shared_ptr<const T> new_value = std::make_shared<const T>(std::forward<Any>(any));
+			const bool need_event = need_trigger_event(get_value(), *new_value);
+
+			this->value.ptr = new_value;
+			lock.unlock();
+
+			if (!need_event) return;
+			m_version.bump();
+			if (event.empty()) return;
+			if (defer_event()) return;
+				event(EventValue{ std::move(new_value) });
+		}
+
+		template<class Any, class AnyLock>
+		void set_value(Any&& any, std::unique_lock<AnyLock>&& lock, std::true_type snapshot_value) {
+			set_value_snapshot(std::forward<Any>(any), std::move(lock));
+		}
+		template<class Any, class AnyLock>
+		void set_value(Any&& any, std::unique_lock<AnyLock>&& lock, std::false_type snapshot_value) {
+			set_value_impl(std::forward<Any>(any), std::move(lock), std::integral_constant<bool, do_blocking>{});
+		}
 	protected:
 		template<class Any, class AnyLock>
 		void set_value(Any&& any, std::unique_lock<AnyLock>&& lock) {
-			set_value_impl(std::forward<Any>(any), std::move(lock), std::integral_constant<bool, do_blocking>{});
+			set_value(std::forward<Any>(any), std::move(lock), std::integral_constant<bool, snapshot_value>{});
 		}
 
 	public:
@@ -213,6 +292,84 @@ namespace details {
 			return shared.get();
 		}
 
+	private:
+		void notify_changed(const T& new_value) {
+			m_version.bump();
+			if (event.empty()) return;
+			if (defer_event()) return;
+			event(new_value);
+		}
+		// CAS loop, fn(T&) modifies copy. Return {old, new}.
+		template<class Fn>
+		std::pair<T, T> cas_modify(Fn&& fn) {
+			T old_value = this->value.load();
+			T new_value = old_value;
+			do {
+				new_value = old_value;
+				fn(new_value);
+			} while (!this->value.compare_exchange_weak(old_value, new_value));
+
+			if (need_trigger_event(old_value, new_value)) notify_changed(new_value);
+			return { old_value, new_value };
+		}
+
+		using native_fetch_add = std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value>;
+		T fetch_add(const T& arg, std::true_type native) {
+			const T old_value = this->value.fetch_add(arg);
+			const T new_value = static_cast<T>(old_value + arg);
+			if (need_trigger_event(old_value, new_value)) notify_changed(new_value);
+			return old_value;
+		}
+		T fetch_add(const T& arg, std::false_type native) {
+			return cas_modify([&](T& value){ value += arg; }).first;
+		}
+		T fetch_sub(const T& arg, std::true_type native) {
+			const T old_value = this->value.fetch_sub(arg);
+			const T new_value = static_cast<T>(old_value - arg);
+			if (need_trigger_event(old_value, new_value)) notify_changed(new_value);
+			return old_value;
+		}
+		T fetch_sub(const T& arg, std::false_type native) {
+			return cas_modify([&](T& value){ value -= arg; }).first;
+		}
+	public:
+		// Lock-free read-modify-write, nonblocking_atomic only. Unlike WriteLock, concurrent updates are not lost.
+		// Event triggered only if value changed, with exactly the value, this operation stored.
+
+		// fn(T&) modifies copy, may be called several times. Return new value.
+		template<class Fn, bool m_atomic = atomic_value, typename = std::enable_if_t<m_atomic> >
+		T modify(Fn&& fn) {
+			return cas_modify(std::forward<Fn>(fn)).second;
+		}
+
+		// return previous value
+		template<bool m_atomic = atomic_value, typename = std::enable_if_t<m_atomic> >
+		T fetch_add(const T& arg) {
+			return fetch_add(arg, native_fetch_add{});
+		}
+		template<bool m_atomic = atomic_value, typename = std::enable_if_t<m_atomic> >
+		T fetch_sub(const T& arg) {
+			return fetch_sub(arg, native_fetch_add{});
+		}
+
+		// return previous value
+		template<bool m_atomic = atomic_value, typename = std::enable_if_t<m_atomic> >
+		T exchange(const T& new_value) {
+			const T old_value = this->value.exchange(new_value);
+			if (need_trigger_event(old_value, new_value)) notify_changed(new_value);
+			return old_value;
+		}
+
+		// on failure, expected = current value
+		template<bool m_atomic = atomic_value, typename = std::enable_if_t<m_atomic> >
+		bool compare_exchange(T& expected, const T& desired) {
+			const T old_value = expected;
+			if (!this->value.compare_exchange_strong(expected, desired)) return false;
+
+			if (need_trigger_event(old_value, desired)) notify_changed(desired);
+			return true;
+		}
+
 		class ReadLockNonCopy {
 			friend Self;
 		protected:
@@ -290,7 +447,42 @@ namespace details {
 			void unlock(){}
 		};
 
-		using ReadLock = std::conditional_t<do_blocking, ReadLockNonCopy, ReadLockAtomic>;
+		class ReadLockSnapshot {
+			friend Self;
+		protected:
+			std::shared_ptr<const T> value;
+
+			static std::shared_ptr<const T> getValue(const Self& self) {
+				std::unique_lock<Lock> tmp_lock(self.m_lock);					// SpinLock
+				return self.value.ptr;
+			}
+
+			ReadLockSnapshot(const Self& self)
+				:value(getValue(self))
+			{}
+		public:
+			ReadLockSnapshot(ReadLockSnapshot&&) = default;
+			ReadLockSnapshot(const ReadLockSnapshot&) = delete;
+
+			const T& get() const {
+				return *value;
+			}
+			operator const T&() const {
+				return get();
+			}
+			const T* operator->() const {
+				return &get();
+			}
+			const T& operator*() const{
+				return get();
+			}
+
+			void unlock(){}
+		};
+
+		using ReadLock = std::conditional_t<do_blocking, ReadLockNonCopy
+			, std::conditional_t<snapshot_value, ReadLockSnapshot, ReadLockAtomic>
+		>;
 
 
 		class WriteLockBase{
@@ -354,6 +546,7 @@ namespace details {
 		private:
 			void finish(std::true_type do_block) {
 				std::shared_lock<Lock> sl(acme::upgrade_lock<Lock>(std::move(lock)));
+				HeldSharedLock held(self->shared_lock_id());
 				self->event(self->value);
 			}
 			void finish(std::false_type do_block) {
@@ -363,7 +556,11 @@ namespace details {
 				self->event(temp_value);
 			}
 			void finish() {
+				self->reset_change_detector();
+				self->m_version.bump();
 				if (this->m_silent) return;
+				if (self->event.empty()) return;
+				if (self->defer_event()) return;
 				finish(std::integral_constant<bool, do_blocking>{});
 			}
 		public:
@@ -427,8 +624,12 @@ namespace details {
 		private:
 			void finish() {
 				self->value = value;
+				self->reset_change_detector();
+				self->m_version.bump();
 
 				if (this->m_silent) return;
+				if (self->event.empty()) return;
+				if (self->defer_event()) return;
 
 				self->event(value);
 			}
@@ -439,7 +640,79 @@ namespace details {
 			}
 		};
 
-		using WriteLock = std::conditional_t<atomic_value, WriteLockAtomic, WriteLockNonCopy>;
+		// modify copy, publish it as new snapshot
+		class WriteLockSnapshot : public WriteLockBase{
+			friend Self;
+		protected:
+			Self* self;
+			std::unique_lock<Lock> lock;		// Lock = SpinLock
+			T value;
+
+			WriteLockSnapshot(Self& self)
+				: self(&self)
+				, lock(self.m_lock)
+				, value(*self.value.ptr)
+			{}
+			WriteLockSnapshot(Self& self, std::unique_lock<Lock>&& lock)
+				: self(&self)
+				, lock(std::move(lock))
+				, value(*self.value.ptr)
+			{}
+		public:
+			WriteLockSnapshot(WriteLockSnapshot&& other)
+				: self(other.self)
+				, lock(std::move(other.lock))
+				, value(std::move(other.value))
+			{
+				other.self = nullptr;
+			}
+
+			WriteLockSnapshot(const WriteLockSnapshot&) = delete;
+
+
+			T& get() {
+				return value;
+			}
+			operator T&() {
+				return get();
+			}
+			T* operator->() {
+				return &get();
+			}
+			T& operator*(){
+				return get();
+			}
+
+			void unlock() {
+				if (!self) return;
+				finish();
+				self = nullptr;
+			}
+
+		private:
+			void finish() {
+				std::shared_ptr<const T> new_value = std::make_shared<const T>(std::move(value));
+				self->value.ptr = new_value;
+				self->reset_change_detector();
+				lock.unlock();
+				self->m_version.bump();
+
+				if (this->m_silent) return;
+				if (self->event.empty()) return;
+				if (self->defer_event()) return;
+
+				self->event(EventValue{ std::move(new_value) });
+			}
+		public:
+			~WriteLockSnapshot(){
+				if (!self) return; // moved?
+				finish();
+			}
+		};
+
+		using WriteLock = std::conditional_t<atomic_value, WriteLockAtomic
+			, std::conditional_t<snapshot_value, WriteLockSnapshot, WriteLockNonCopy>
+		>;
 
 	protected:
 		template<class AnyLock>
@@ -459,20 +732,109 @@ namespace details {
 	private:
 		void do_pulse(std::true_type do_blocking) const {
 			std::shared_lock<Lock> sl(m_lock);
+			HeldSharedLock held(shared_lock_id());
 			event(this->value);
 		}
 		void do_pulse(std::false_type do_blocking) const {
-			event(getCopy());
+			event(event_value());
+		}
+
+		EventValue event_value(std::true_type snapshot_value) const {
+			std::unique_lock<Lock> l(m_lock);
+			return EventValue{ value.ptr };
+		}
+		EventValue event_value(std::false_type snapshot_value) const {
+			return getCopy();
 		}
 	public:
+		// current value, as it passed to event
+		EventValue event_value() const {
+			return event_value(std::integral_constant<bool, snapshot_value>{});
+		}
+
 		void pulse() const{
+			if (event.empty()) return;
 			do_pulse(std::integral_constant<bool, do_blocking>{});
 		}
 
+	private:
+		// Inside Transaction - postpone event till commit, once per property
+		bool defer_event() const {
+			reactive::details::TransactionState* transaction = reactive::details::TransactionState::current();
+			if (!transaction) return false;
+			transaction->defer_event(this);
+			return true;
+		}
+
+	public:
+		// Write counter. Changes on each value change / WriteLock release.
+		unsigned version() const {
+			return m_version.version();
+		}
+		// Park thread (futex), until version() != version. Return new version.
+		unsigned wait_for_change(unsigned version) const {
+			return m_version.wait_for_change(version);
+		}
+		// Park thread, until value satisfy pred. Return that value.
+		template<class Pred>
+		T wait_until(Pred&& pred) const {
+			while (true) {
+				const unsigned version = this->version();
+				T value = getCopy();
+				if (pred(static_cast<const T&>(value))) return value;
+				wait_for_change(version);
+			}
+		}
+
+	private:
+		class ReadLockRef {
+			const T& value;
+		public:
+			ReadLockRef(const T& value)
+				: value(value) {}
+
+			const T& get() const {
+				return value;
+			}
+		};
+		ReadLockRef read_locked(std::true_type do_blocking) const {
+			return { this->value };
+		}
+		ReadLock read_locked(std::false_type do_blocking) const {
+			return lock();
+		}
+	public:
+		// Raw shared lock, for observers, which lock several blocking properties in order.
+		// Only for blocking properties.
+		const void* shared_lock_id() const {
+			return this;
+		}
+		// overtakes waiting writers, see upgrade_mutex::try_lock_shared_barging
+		bool try_lock_shared_barging() const {
+			return m_lock.try_lock_shared_barging();
+		}
+		void lock_shared() const {
+			m_lock.lock_shared();
+		}
+		void unlock_shared() const {
+			m_lock.unlock_shared();
+		}
+
+		// Value reference, for use while lock_shared() held.
+		// Non-blocking property - ReadLock (copy).
+		auto read_locked() const {
+			return read_locked(std::integral_constant<bool, do_blocking>{});
+		}
+
 	};
 
-	template<class T, class blocking_class = reactive::default_blocking, class friend_class = std::true_type>
-	using ObservableProperty = ObservablePropertyConfigurable<T, blocking_class, friend_class>;
+	template<class T, class blocking_class = reactive::default_blocking, class friend_class = std::true_type, class change_detection_policy = reactive::change_detection::equal>
+	using ObservableProperty = ObservablePropertyConfigurable<T, blocking_class, friend_class
+		, typename details::Settings<T, blocking_class>::Lock
+		, threading::SpinLock<threading::SpinLockMode::Yield>
+		, std::shared_mutex
+		, change_detection_policy
+	>;
 }
 }
 
@@ -0,0 +1,210 @@
+#ifndef REACTIVE_DETAILS_OBSERVABLEPROPERTYARRAY_H
+#define REACTIVE_DETAILS_OBSERVABLEPROPERTYARRAY_H
+
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <utility>
+#include <algorithm>
+
+#include "threading/SpinLock.h"
+#include "ChangeDetector.h"
+#include "Delegate.h"
+#include "Transaction.h"
+#include "../blocking.h"
+
+namespace reactive {
+namespace details {
+
+	// thread-safe, non-blocking.
+	// Fixed size array of properties: values contiguous, guarded by striped SpinLocks (element i - stripe i % stripes).
+	// Subscribers kept in one table, by element index - created on first subscribe/observe of element.
+	// Never observed element costs sizeof(T). Once observed, element node stays in table while array lives
+	// (observers and Transaction point to it), only its subscriber list freed when last subscriber removed.
+	template<class T, std::size_t stripes = 64>
+	class ObservablePropertyArray {
+		static_assert((stripes & (stripes - 1)) == 0, "stripes must be power of 2");
+
+		using Self = ObservablePropertyArray;
+		using Lock = threading::SpinLock<threading::SpinLockMode::Adaptive>;
+		using Subscribers = std::vector<std::pair<DelegateTag, std::function<void(const T&)>>>;
+
+	public:
+		// Observable element (for observe / bind / ReactiveProperty::set). Lives while array lives.
+		class Element {
+			friend Self;
+			const Self* array;
+			std::size_t index;
+			mutable std::shared_ptr<const Subscribers> subscribers;		// copy on write, under stripe lock
+
+			template<class Fn>
+			void update_subscribers(Fn&& fn) const {
+				Stripe& s = array->stripe(index);
+				std::unique_lock<Lock> l(s.lock);
+				auto list = subscribers ? std::make_shared<Subscribers>(*subscribers) : std::make_shared<Subscribers>();
+				fn(*list);
+				if (list->empty()) {
+					subscribers.reset();
+				} else {
+					subscribers = std::move(list);
+				}
+			}
+		public:
+			using Value = T;
+			using EventValue = T;
+			using blocking_mode = reactive::nonblocking;
+			static constexpr const bool threadsafe = true;
+
+			Element(const Self* array, std::size_t index)
+				: array(array)
+				, index(index) {}
+
+			T getCopy() const {
+				return array->get(index);
+			}
+			T event_value() const {
+				return getCopy();
+			}
+			void pulse() const {
+				array->pulse(index);
+			}
+
+			// event control
+			template<class Fn>
+			void subscribe(const DelegateTag& tag, Fn&& fn) const {
+				update_subscribers([&](Subscribers& list) {
+					list.emplace_back(tag, std::forward<Fn>(fn));
+				});
+			}
+			template<class Closure>
+			void operator+=(Closure&& closure) const {
+				subscribe(DelegateTagEmpty{}, std::forward<Closure>(closure));
+			}
+			void operator-=(const DelegateTag& tag) const {
+				update_subscribers([&](Subscribers& list) {
+					list.erase(std::remove_if(list.begin(), list.end(), [&](const auto& subscriber) {
+						return subscriber.first == tag;
+					}), list.end());
+				});
+			}
+		};
+
+	private:
+		struct alignas(64) Stripe {
+			mutable Lock lock;
+			std::unordered_map<std::size_t, Element> elements;		// node based - element address stable
+		};
+
+		std::unique_ptr<T[]> m_values;
+		std::size_t m_size;
+		mutable std::array<Stripe, stripes> m_stripes;
+
+		Stripe& stripe(std::size_t index) const {
+			return m_stripes[index & (stripes - 1)];
+		}
+
+		static bool equal(const T& l, const T& r, std::true_type) {
+			return l == r;
+		}
+		static bool equal(const T&, const T&, std::false_type) {
+			return false;
+		}
+
+		// subscribed element or nullptr
+		const Element* observed(const Stripe& s, std::size_t index) const {
+			auto it = s.elements.find(index);
+			if (it == s.elements.end() || !it->second.subscribers) return nullptr;
+			return &it->second;
+		}
+
+		// unlock, call subscribers with value copied under lock
+		void call_subscribers(std::unique_lock<Lock>& lock, const Element& element) const {
+			std::shared_ptr<const Subscribers> subscribers = element.subscribers;
+			const T value = m_values[element.index];
+			lock.unlock();
+
+			for (const auto& subscriber : *subscribers) subscriber.second(value);
+		}
+
+		void notify(std::unique_lock<Lock>& lock, const Stripe& s, std::size_t index) const {
+			const Element* element = observed(s, index);
+			if (!element) return;
+
+			// Inside Transaction - postpone till commit, once per element
+			if (reactive::details::TransactionState* transaction = reactive::details::TransactionState::current()) {
+				lock.unlock();
+				transaction->defer_event(element);
+				return;
+			}
+			call_subscribers(lock, *element);
+		}
+
+	public:
+		using Value = T;
+
+		explicit ObservablePropertyArray(std::size_t size, const T& value = T())
+			: m_values(new T[size])
+			, m_size(size)
+		{
+			std::fill(m_values.get(), m_values.get() + size, value);
+		}
+		ObservablePropertyArray(const ObservablePropertyArray&) = delete;
+
+		// pending Transaction events of this thread
+		~ObservablePropertyArray() {
+			if (!reactive::details::TransactionState::current()) return;
+			for (const Stripe& s : m_stripes) {
+				for (const auto& element : s.elements) reactive::details::TransactionState::forget_event(&element.second);
+			}
+		}
+
+		std::size_t size() const {
+			return m_size;
+		}
+
+		T get(std::size_t index) const {
+			const Stripe& s = stripe(index);
+			std::unique_lock<Lock> l(s.lock);
+			return m_values[index];
+		}
+
+		// equal value (if T have operator==) - no event
+		template<class Value>
+		void set(std::size_t index, Value&& value) {
+			Stripe& s = stripe(index);
+			std::unique_lock<Lock> l(s.lock);
+			if (equal(m_values[index], value, std::integral_constant<bool, has_equal_op<T>::value>{})) return;
+			m_values[index] = std::forward<Value>(value);
+			notify(l, s, index);
+		}
+
+		// fn(T&), under stripe lock - keep it short. Always triggers event.
+		template<class Fn>
+		void modify(std::size_t index, Fn&& fn) {
+			Stripe& s = stripe(index);
+			std::unique_lock<Lock> l(s.lock);
+			fn(m_values[index]);
+			notify(l, s, index);
+		}
+
+		void pulse(std::size_t index) const {
+			const Stripe& s = stripe(index);
+			std::unique_lock<Lock> l(s.lock);
+			if (const Element* element = observed(s, index)) call_subscribers(l, *element);
+		}
+
+		// created on first request
+		Element& element(std::size_t index) const {
+			Stripe& s = stripe(index);
+			std::unique_lock<Lock> l(s.lock);
+			return s.elements.try_emplace(index, this, index).first->second;
+		}
+	};
+
+}
+}
+
+#endif //REACTIVE_DETAILS_OBSERVABLEPROPERTYARRAY_H
@@ -0,0 +1,286 @@
+#ifndef REACTIVE_DETAILS_OBSERVABLEVECTOR_H
+#define REACTIVE_DETAILS_OBSERVABLEVECTOR_H
+
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+#include <algorithm>
+#include <utility>
+
+#include "threading/upgrade_mutex.h"
+#include "threading/SpinLock.h"
+#include "Event.h"
+
+namespace reactive {
+
+	// One change of ObservableVector. [first, last) - indices at the moment of change
+	// (after all previous changes of the same diff applied).
+	struct VectorChange {
+		enum Kind { insert, erase, update };
+
+		Kind kind;
+		std::size_t first;
+		std::size_t last;
+	};
+	using VectorDiff = std::vector<VectorChange>;
+
+namespace details {
+
+	// Changes of one write scope, adjacent ones merged.
+	inline void record_change(VectorDiff& diff, VectorChange::Kind kind, std::size_t first, std::size_t last) {
+		if (first == last) return;
+
+		if (!diff.empty()) {
+			VectorChange& back = diff.back();
+			switch (kind) {
+			case VectorChange::update:
+				// inside just inserted - already new
+				if (back.kind == VectorChange::insert && first >= back.first && last <= back.last) return;
+				if (back.kind == VectorChange::update && first <= back.last && last >= back.first) {
+					back.first = std::min(back.first, first);
+					back.last  = std::max(back.last, last);
+					return;
+				}
+				break;
+			case VectorChange::insert:
+				if (back.kind == VectorChange::insert && first >= back.first && first <= back.last) {
+					back.last += last - first;
+					return;
+				}
+				break;
+			case VectorChange::erase:
+				// erased range, which covers position of previous erase
+				if (back.kind == VectorChange::erase && first <= back.first && last >= back.first) {
+					back.last  = back.last + (last - back.first);
+					back.first = first;
+					return;
+				}
+				break;
+			}
+		}
+		diff.push_back({ kind, first, last });
+	}
+
+
+	// thread-safe, blocking (upgrade_mutex): event called under shared lock, with diff and vector reference
+	template<class T>
+	class ObservableVector {
+		using Self = ObservableVector<T>;
+		using Lock = acme::upgrade_mutex;
+
+		mutable Lock m_lock;
+		std::vector<T> m_values;
+		VectorDiff m_diff;			// of current write scope, reused (under unique lock)
+		mutable ConfigurableEvent<threading::SpinLock<threading::SpinLockMode::Yield>, std::shared_mutex
+			, const VectorDiff&, const std::vector<T>&> event;
+
+	public:
+		using Value = std::vector<T>;
+
+		ObservableVector() {}
+		ObservableVector(std::vector<T> values)
+			: m_values(std::move(values)) {}
+
+		// do not copy event list
+		ObservableVector(const ObservableVector& other)
+			: m_values(other.getCopy()) {}
+
+		// event control (non-blocking)
+		template<class DelegateT>
+		void operator+=(DelegateT&& closure) const {
+			event += std::forward<DelegateT>(closure);
+		}
+		template<class Fn>
+		void subscribe(const DelegateTag& tag, Fn&& fn) const {
+			event.subscribe(tag, std::forward<Fn>(fn));
+		}
+		template<class Delegate>
+		void operator-=(Delegate&& closure) const {
+			event -= std::forward<Delegate>(closure);
+		}
+
+
+		class ReadLock {
+			friend Self;
+		protected:
+			std::shared_lock<Lock> lock;
+			const Self* self;
+
+			ReadLock(const Self& self)
+				: lock(self.m_lock)
+				, self(&self) {}
+		public:
+			ReadLock(ReadLock&&) = default;
+
+			const std::vector<T>& get() const {
+				return self->m_values;
+			}
+			operator const std::vector<T>&() const {
+				return get();
+			}
+			const std::vector<T>* operator->() const {
+				return &get();
+			}
+			const std::vector<T>& operator*() const {
+				return get();
+			}
+
+			void unlock() {
+				lock.unlock();
+			}
+		};
+
+		// Edits recorded to diff. Event with diff triggered on destruction / unlock(), if there was changes.
+		class WriteLock {
+			friend Self;
+		protected:
+			Self* self;
+			std::unique_lock<Lock> lock;
+
+			WriteLock(Self& self)
+				: self(&self)
+				, lock(self.m_lock)
+			{
+				self.m_diff.clear();
+			}
+
+			std::vector<T>& values() {
+				return self->m_values;
+			}
+			void record(VectorChange::Kind kind, std::size_t first, std::size_t last) {
+				record_change(self->m_diff, kind, first, last);
+			}
+		public:
+			WriteLock(WriteLock&& other)
+				: self(other.self)
+				, lock(std::move(other.lock))
+			{
+				other.self = nullptr;
+			}
+			WriteLock(const WriteLock&) = delete;
+
+			// read
+			const std::vector<T>& get() const {
+				return self->m_values;
+			}
+			const T& operator[](std::size_t i) const {
+				return self->m_values[i];
+			}
+			std::size_t size() const {
+				return self->m_values.size();
+			}
+			bool empty() const {
+				return self->m_values.empty();
+			}
+
+			// update
+			// element reference, recorded as updated
+			T& modify(std::size_t i) {
+				record(VectorChange::update, i, i + 1);
+				return values()[i];
+			}
+			template<class U>
+			void set(std::size_t i, U&& value) {
+				modify(i) = std::forward<U>(value);
+			}
+
+			// insert
+			template<class ...Args>
+			T& emplace(std::size_t i, Args&&...args) {
+				auto it = values().emplace(values().begin() + i, std::forward<Args>(args)...);
+				record(VectorChange::insert, i, i + 1);
+				return *it;
+			}
+			template<class U>
+			void insert(std::size_t i, U&& value) {
+				emplace(i, std::forward<U>(value));
+			}
+			template<class It>
+			void insert(std::size_t i, It first, It last) {
+				const std::size_t old_size = values().size();
+				values().insert(values().begin() + i, first, last);
+				record(VectorChange::insert, i, i + (values().size() - old_size));
+			}
+			template<class ...Args>
+			T& emplace_back(Args&&...args) {
+				return emplace(values().size(), std::forward<Args>(args)...);
+			}
+			template<class U>
+			void push_back(U&& value) {
+				emplace_back(std::forward<U>(value));
+			}
+
+			// erase
+			void erase(std::size_t first, std::size_t last) {
+				values().erase(values().begin() + first, values().begin() + last);
+				record(VectorChange::erase, first, last);
+			}
+			void erase(std::size_t i) {
+				erase(i, i + 1);
+			}
+			void pop_back() {
+				erase(values().size() - 1);
+			}
+			void clear() {
+				erase(0, values().size());
+			}
+
+			void resize(std::size_t size) {
+				const std::size_t old_size = values().size();
+				if (size < old_size) {
+					erase(size, old_size);
+				} else {
+					values().resize(size);
+					record(VectorChange::insert, old_size, size);
+				}
+			}
+
+			// whole vector replaced
+			void assign(std::vector<T> new_values) {
+				clear();
+				values() = std::move(new_values);
+				record(VectorChange::insert, 0, values().size());
+			}
+
+			void unlock() {
+				if (!self) return;
+				finish();
+				self = nullptr;
+			}
+		private:
+			void finish() {
+				if (self->m_diff.empty()) {
+					lock.unlock();
+					return;
+				}
+
+				std::shared_lock<Lock> sl(acme::upgrade_lock<Lock>(std::move(lock)));
+				self->event(self->m_diff, self->m_values);
+			}
+		public:
+			~WriteLock() {
+				if (!self) return; // moved?
+				finish();
+			}
+		};
+
+		ReadLock lock() const {
+			return { *this };
+		}
+		WriteLock write_lock() {
+			return { *this };
+		}
+
+		std::vector<T> getCopy() const {
+			return lock().get();
+		}
+
+		void operator=(std::vector<T> values) {
+			write_lock().assign(std::move(values));
+		}
+	};
+
+}
+}
+
+#endif //REACTIVE_DETAILS_OBSERVABLEVECTOR_H
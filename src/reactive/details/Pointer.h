@@ -0,0 +1,39 @@
+#ifndef REACTIVE_DETAILS_POINTER_H
+#define REACTIVE_DETAILS_POINTER_H
+
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+#include "../intrusive/ptr.h"
+
+namespace reactive {
+namespace details {
+
+	// Smart pointer family, which owns property data. See also intrusive::pointer.
+	struct std_pointer {
+		template<class T>
+		using shared_ptr = std::shared_ptr<T>;
+		template<class T>
+		using weak_ptr = std::weak_ptr<T>;
+
+		template<class T, class ...Args>
+		static std::shared_ptr<T> make_shared(Args&&...args) {
+			return std::make_shared<T>(std::forward<Args>(args)...);
+		}
+	};
+
+	// Non thread safe owners never share pointer between threads - plain integer counts.
+	template<bool threadsafe>
+	using pointer_for = std::conditional_t<threadsafe, std_pointer, intrusive::pointer<false>>;
+
+	// observable element type / weak pointer of any shared pointer (std or intrusive)
+	template<class SharedPtr>
+	using element_t = typename SharedPtr::element_type;
+	template<class SharedPtr>
+	using weak_t = typename SharedPtr::weak_type;
+
+}
+}
+
+#endif //REACTIVE_DETAILS_POINTER_H
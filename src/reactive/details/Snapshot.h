@@ -0,0 +1,69 @@
+#ifndef REACTIVE_DETAILS_SNAPSHOT_H
+#define REACTIVE_DETAILS_SNAPSHOT_H
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace reactive {
+
+	// Immutable value of property in reactive::snapshot mode.
+	// Property publish one snapshot per set, observers share it.
+	template<class T>
+	class Snapshot {
+		std::shared_ptr<const T> ptr;
+	public:
+		explicit Snapshot(std::shared_ptr<const T> ptr)
+			: ptr(std::move(ptr)) {}
+
+		const T& get() const {
+			return *ptr;
+		}
+		operator const T&() const {
+			return get();
+		}
+		const T* operator->() const {
+			return &get();
+		}
+		const T& operator*() const {
+			return get();
+		}
+
+		const std::shared_ptr<const T>& shared_ptr() const {
+			return ptr;
+		}
+	};
+
+namespace details {
+
+	// Value storage of property in reactive::snapshot mode.
+	template<class T>
+	struct SnapshotStorage {
+		std::shared_ptr<const T> ptr;
+
+		SnapshotStorage()
+			: ptr(std::make_shared<const T>()) {}
+
+		template<
+			class Arg, class ...Args
+			, class = std::enable_if_t< !std::is_same< std::decay_t<Arg>, SnapshotStorage >::value >
+		>
+		SnapshotStorage(Arg&& arg, Args&&...args)
+			: ptr(std::make_shared<const T>(std::forward<Arg>(arg), std::forward<Args>(args)...)) {}
+	};
+
+
+	// Snapshot<T> -> const T&, observers pass values to closures through this.
+	template<class T>
+	const T& unwrap(const T& value) {
+		return value;
+	}
+	template<class T>
+	const T& unwrap(const Snapshot<T>& snapshot) {
+		return snapshot.get();
+	}
+
+}
+}
+
+#endif	//REACTIVE_DETAILS_SNAPSHOT_H
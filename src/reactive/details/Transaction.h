@@ -0,0 +1,131 @@
+#ifndef REACTIVE_DETAILS_TRANSACTION_H
+#define REACTIVE_DETAILS_TRANSACTION_H
+
+#include <vector>
+#include <memory>
+
+#include "../Subscription.h"
+#include "utils/PointerMap.h"
+
+namespace reactive {
+namespace details {
+
+	// Deferred notifications of current thread transaction. See reactive::Transaction.
+	// Only notifications deferred - writes themselves are applied immediately, not buffered.
+	// Each action stored once per pending id (property / observer), dedup in O(1).
+	// Thread local, buffers reused between transactions - no allocations in steady state
+	// (actions hold observer pointer inline, see Subscription).
+	class TransactionState {
+		struct Action {
+			const void* id;
+			Subscription run;		// empty - forgotten
+		};
+		using Actions = std::vector<Action>;
+		struct Queue {
+			Actions actions;
+			std::size_t head = 0;						// pending from head
+			utils::PointerMap<std::size_t> pending;		// id -> index in actions
+
+			bool empty() const {
+				return head == actions.size();
+			}
+
+			template<class MakeRun>
+			void push(const void* id, MakeRun&& make_run) {
+				if (!pending.insert(id, actions.size())) return;
+				actions.push_back({ id, make_run() });
+			}
+
+			// action may push
+			void run_one() {
+				const Action action = std::move(actions[head++]);
+				pending.erase(action.id);
+				if (action.run) action.run();
+			}
+
+			void forget(const void* id) {
+				std::size_t* index = pending.find(id);
+				if (!index) return;
+				actions[*index].run = nullptr;
+				pending.erase(id);
+			}
+
+			void clear() {
+				actions.clear();
+				head = 0;
+				pending.clear();
+			}
+		};
+		Queue events;			// property pulses
+		Queue observers;		// observer executions
+		int depth = 0;
+
+		// Deliver all pending events (observers deferred), then run one observer (its output deferred), repeat.
+		// Observer, which input still pending, runs after it (if it was deferred later) - once.
+		void commit() {
+			while (true) {
+				while (!events.empty()) events.run_one();
+				if (observers.empty()) break;
+				observers.run_one();
+			}
+			events.clear();
+			observers.clear();
+		}
+
+		static TransactionState& instance() {
+			static thread_local TransactionState state;
+			return state;
+		}
+	public:
+		// nullptr - no transaction on this thread
+		static TransactionState* current() {
+			TransactionState& state = instance();
+			return state.depth > 0 ? &state : nullptr;
+		}
+
+		static void begin() {
+			instance().depth++;
+		}
+		// outermost commits
+		static void end() {
+			TransactionState& state = instance();
+			if (state.depth == 1) {
+				try {
+					state.commit();
+				} catch (...) {
+					state.events.clear();
+					state.observers.clear();
+					state.depth--;
+					throw;
+				}
+			}
+			state.depth--;
+		}
+
+		// Property destroyed - drop its pending event. Properties destroyed on other thread must outlive transaction.
+		static void forget_event(const void* property) {
+			if (TransactionState* transaction = current()) transaction->events.forget(property);
+		}
+
+		template<class Property>
+		void defer_event(const Property* property) {
+			events.push(property, [&]() {
+				return Subscription([property]() { property->pulse(); });
+			});
+		}
+		// ObserverPtr - std::shared_ptr / intrusive::shared_ptr, held till run
+		template<class ObserverPtr>
+		void defer_observer(const ObserverPtr& observer) {
+			observers.push(observer.get(), [&]() {
+				return Subscription([observer]() {
+					if (observer->is_unsubscribed()) return;
+					observer->execute();
+				});
+			});
+		}
+	};
+
+}
+}
+
+#endif //REACTIVE_DETAILS_TRANSACTION_H
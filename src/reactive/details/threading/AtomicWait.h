@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <climits>
+
+#if defined(__cpp_lib_atomic_wait)
+	// std::atomic::wait
+#elif defined(__linux__)
+	#include <unistd.h>
+	#include <sys/syscall.h>
+	#include <linux/futex.h>
+	#define REACTIVE_THREADING_FUTEX
+#endif
+
+namespace threading {
+
+	// Park thread while word == old. Spurious wake ups possible.
+	inline void atomic_wait(const std::atomic<unsigned>& word, unsigned old) {
+#if defined(__cpp_lib_atomic_wait)
+		word.wait(old, std::memory_order_acquire);
+#elif defined(REACTIVE_THREADING_FUTEX)
+		static_assert(sizeof(std::atomic<unsigned>) == sizeof(unsigned), "futex require plain 32 bit word");
+		syscall(SYS_futex, reinterpret_cast<const unsigned*>(&word), FUTEX_WAIT_PRIVATE, old, nullptr, nullptr, 0);
+#else
+		// fallback - yield, then sleep
+		for (int i = 0; i < 1000 && word.load(std::memory_order_acquire) == old; ++i) {
+			std::this_thread::yield();
+		}
+		while (word.load(std::memory_order_acquire) == old) {
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+#endif
+	}
+
+	inline void atomic_notify_all(std::atomic<unsigned>& word) {
+#if defined(__cpp_lib_atomic_wait)
+		word.notify_all();
+#elif defined(REACTIVE_THREADING_FUTEX)
+		syscall(SYS_futex, reinterpret_cast<unsigned*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+		(void)word;
+#endif
+	}
+
+
+	// Change counter, with waiters bit (bit 0). Writer do syscall, only if someone waits.
+	class VersionWord {
+		static constexpr const unsigned waiters_bit = 1;
+		static constexpr const unsigned step = 2;
+
+		mutable std::atomic<unsigned> word{0};
+	public:
+		unsigned version() const {
+			return word.load(std::memory_order_acquire) >> 1;
+		}
+
+		// after value changed
+		void bump() {
+			const unsigned old = word.fetch_add(step, std::memory_order_acq_rel);
+			if (!(old & waiters_bit)) return;
+
+			word.fetch_and(~waiters_bit, std::memory_order_relaxed);
+			atomic_notify_all(word);
+		}
+
+		// return new version
+		unsigned wait_for_change(unsigned version) const {
+			while (true) {
+				unsigned current = word.load(std::memory_order_acquire);
+				if ((current >> 1) != version) return current >> 1;
+
+				if (!(current & waiters_bit)) {
+					if (!word.compare_exchange_weak(current, current | waiters_bit, std::memory_order_acq_rel)) continue;
+					current |= waiters_bit;
+				}
+				atomic_wait(word, current);
+			}
+		}
+	};
+
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "SpinLock.h"
+
+namespace threading {
+
+	// Tuple of values, written per element and read whole, from many threads.
+	// store<I>(value) - replace element I. load() - copy of all elements. store_load<I>(value) - both.
+
+	// Lock-free, each element in own std::atomic - writers of different elements never contend.
+	// Weaker than locked: each loaded element is whole and latest for its own slot,
+	// but elements may come from different moments (combination may never have existed at once).
+	template<class ...Ts>
+	class AtomicSlots {
+		std::tuple<std::atomic<Ts>...> values;
+
+		template<std::size_t ...Is>
+		std::tuple<Ts...> load(std::index_sequence<Is...>) const {
+			return std::tuple<Ts...>(std::get<Is>(values).load(std::memory_order_acquire)...);
+		}
+	public:
+		template<class ...Args>
+		AtomicSlots(Args&&... values)
+			: values(std::forward<Args>(values)...) {}
+
+		template<std::size_t I, class Arg>
+		void store(Arg&& value) {
+			std::get<I>(values).store(std::forward<Arg>(value), std::memory_order_release);
+		}
+		std::tuple<Ts...> load() const {
+			return load(std::index_sequence_for<Ts...>{});
+		}
+		template<std::size_t I, class Arg>
+		std::tuple<Ts...> store_load(Arg&& value) {
+			store<I>(std::forward<Arg>(value));
+			return load();
+		}
+	};
+
+
+	// One SpinLock over whole tuple - consistent load(), single copy.
+	// For bigger / non trivially copyable elements cheaper than per element synchronization.
+	template<class ...Ts>
+	class LockedSlots {
+		using Lock = SpinLock<SpinLockMode::Adaptive>;
+		mutable Lock lock;
+		std::tuple<Ts...> values;
+	public:
+		template<class ...Args>
+		LockedSlots(Args&&... values)
+			: values(std::forward<Args>(values)...) {}
+
+		template<std::size_t I, class Arg>
+		void store(Arg&& value) {
+			std::unique_lock<Lock> l(lock);
+			std::get<I>(values) = std::forward<Arg>(value);
+		}
+		std::tuple<Ts...> load() const {
+			std::unique_lock<Lock> l(lock);
+			return values;
+		}
+		template<std::size_t I, class Arg>
+		std::tuple<Ts...> store_load(Arg&& value) {
+			std::unique_lock<Lock> l(lock);
+			std::get<I>(values) = std::forward<Arg>(value);
+			return values;
+		}
+	};
+
+
+	// Single thread only.
+	template<class ...Ts>
+	class PlainSlots {
+		std::tuple<Ts...> values;
+	public:
+		template<class ...Args>
+		PlainSlots(Args&&... values)
+			: values(std::forward<Args>(values)...) {}
+
+		template<std::size_t I, class Arg>
+		void store(Arg&& value) {
+			std::get<I>(values) = std::forward<Arg>(value);
+		}
+		const std::tuple<Ts...>& load() const {
+			return values;
+		}
+		template<std::size_t I, class Arg>
+		const std::tuple<Ts...>& store_load(Arg&& value) {
+			store<I>(std::forward<Arg>(value));
+			return values;
+		}
+	};
+
+
+	namespace details {
+		template<class T>
+		using is_lock_free_slot = std::integral_constant<bool,
+			std::is_trivially_copyable<T>::value
+			&& (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) && alignof(T) == sizeof(T)
+		>;
+	}
+
+	// LockedSlots by default - consistent load().
+	// atomic = true - opt-in AtomicSlots, if all elements fit lock-free atomic
+	// (per element seqlock / lock of e.g. 24 byte elements was ~2x slower for single writer than one locked copy).
+	// threadsafe = false - all writers and readers in one thread.
+	template<bool threadsafe, bool atomic, class ...Ts>
+	using ValueSlots = std::conditional_t<
+		!threadsafe
+		, PlainSlots<Ts...>
+		, std::conditional_t<
+			atomic && std::conjunction<details::is_lock_free_slot<Ts>...>::value
+			, AtomicSlots<Ts...>
+			, LockedSlots<Ts...>
+		>
+	>;
+
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <exception>
+#include <type_traits>
+
+#include "SpinLock.h"
+
+namespace threading {
+
+	// Fixed size thread pool. Each worker have own task deque:
+	// owner pops from back, idle workers steal from front of others.
+	// parallel_for pushes whole range onto calling thread's deque; whoever runs range
+	// splits it in halves, leaving upper half in own deque for stealing.
+	// Thread, which calls parallel_for, works as one more worker until batch done.
+	class WorkStealingPool {
+		using Lock = SpinLock<SpinLockMode::Adaptive>;
+
+		// lives on parallel_for caller's stack, until remaining == 0
+		struct Batch {
+			void (*run)(void* closure, std::size_t i);
+			void* closure;
+			std::atomic<std::size_t> remaining;
+			std::atomic<bool> failed{false};
+			std::exception_ptr error;
+		};
+
+		struct Task {
+			Batch* batch;
+			std::size_t begin;
+			std::size_t end;
+		};
+
+		struct Worker {
+			Lock lock;
+			std::deque<Task> tasks;
+		};
+
+		std::vector<std::unique_ptr<Worker>> workers;		// last one - for calling thread
+		std::vector<std::thread> threads;
+
+		std::atomic<std::size_t> queued{0};
+		std::atomic<std::size_t> sleeping{0};
+
+		std::mutex sleep_mutex;
+		std::condition_variable sleep_cv;
+		bool stop = false;
+
+		bool pop(std::size_t index, Task& task) {
+			Worker& worker = *workers[index];
+			std::unique_lock<Lock> l(worker.lock);
+			if (worker.tasks.empty()) return false;
+
+			task = worker.tasks.back();
+			worker.tasks.pop_back();
+			return true;
+		}
+
+		bool steal(std::size_t index, Task& task) {
+			const std::size_t size = workers.size();
+			for (std::size_t i = 1; i < size; ++i) {
+				Worker& worker = *workers[(index + i) % size];
+				std::unique_lock<Lock> l(worker.lock);
+				if (worker.tasks.empty()) continue;
+
+				task = worker.tasks.front();
+				worker.tasks.pop_front();
+				return true;
+			}
+			return false;
+		}
+
+		void push(std::size_t index, const Task& task) {
+			Worker& worker = *workers[index];
+			{
+				std::unique_lock<Lock> l(worker.lock);
+				worker.tasks.push_back(task);
+			}
+			queued.fetch_add(1);
+
+			if (sleeping.load() > 0) {
+				{ std::unique_lock<std::mutex> l(sleep_mutex); }
+				sleep_cv.notify_one();
+			}
+		}
+
+		void run(std::size_t index, Task task) {
+			Batch& batch = *task.batch;
+
+			// split while range is divisible - upper halves may be stolen
+			while (task.end - task.begin > 1) {
+				const std::size_t middle = task.begin + (task.end - task.begin) / 2;
+				push(index, Task{task.batch, middle, task.end});
+				task.end = middle;
+			}
+
+			// after first exception, rest of batch skipped
+			if (!batch.failed.load(std::memory_order_relaxed)) {
+				try {
+					batch.run(batch.closure, task.begin);
+				} catch (...) {
+					if (!batch.failed.exchange(true)) {
+						batch.error = std::current_exception();
+					}
+				}
+			}
+
+			// last access to batch - caller may return right after
+			batch.remaining.fetch_sub(1, std::memory_order_acq_rel);
+		}
+
+		bool try_run(std::size_t index) {
+			Task task;
+			if (!pop(index, task) && !steal(index, task)) return false;
+
+			queued.fetch_sub(1);
+			run(index, task);
+			return true;
+		}
+
+		void worker_loop(std::size_t index) {
+			while (true) {
+				if (try_run(index)) continue;
+
+				std::unique_lock<std::mutex> l(sleep_mutex);
+				sleeping.fetch_add(1);
+				sleep_cv.wait(l, [&]() { return stop || queued.load() > 0; });
+				sleeping.fetch_sub(1);
+				if (stop) return;
+			}
+		}
+
+	public:
+		explicit WorkStealingPool(std::size_t threads_count = std::thread::hardware_concurrency()) {
+			if (threads_count == 0) threads_count = 1;
+
+			// calling thread is a worker too
+			for (std::size_t i = 0; i < threads_count; ++i) {
+				workers.emplace_back(new Worker);
+			}
+
+			threads.reserve(threads_count - 1);
+			for (std::size_t i = 0; i + 1 < threads_count; ++i) {
+				threads.emplace_back([this, i]() { worker_loop(i); });
+			}
+		}
+
+		WorkStealingPool(const WorkStealingPool&) = delete;
+		WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+		~WorkStealingPool() {
+			{
+				std::unique_lock<std::mutex> l(sleep_mutex);
+				stop = true;
+			}
+			sleep_cv.notify_all();
+
+			for (std::thread& thread : threads) {
+				thread.join();
+			}
+		}
+
+		std::size_t size() const {
+			return workers.size();
+		}
+
+		// closure(std::size_t i) for i in [0, count). Return when all done.
+		// First exception thrown by closure rethrown here, after all tasks finished.
+		// Should not be called concurrently.
+		template<class Closure>
+		void parallel_for(std::size_t count, Closure&& closure) {
+			if (count == 0) return;
+
+			using C = std::remove_reference_t<Closure>;
+			Batch batch;
+			batch.run = [](void* closure, std::size_t i) { (*static_cast<C*>(closure))(i); };
+			batch.closure = const_cast<void*>(static_cast<const void*>(std::addressof(closure)));
+			batch.remaining.store(count, std::memory_order_relaxed);
+
+			const std::size_t self = workers.size() - 1;
+			push(self, Task{&batch, 0, count});
+
+			while (batch.remaining.load(std::memory_order_acquire) != 0) {
+				if (!try_run(self)) {
+					std::this_thread::yield();
+				}
+			}
+
+			if (batch.error) std::rethrow_exception(batch.error);
+		}
+	};
+
+}
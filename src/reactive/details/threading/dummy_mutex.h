@@ -8,13 +8,14 @@ namespace threading {
 
 		void lock_shared() {}
 		bool try_lock_shared() { return true; };
+		bool try_lock_shared_barging() { return true; };
 		void unlock_shared() {}
 
 		/*void shared_lock() {}
 		void shared_unlock() {}*/
 
 		void unlock_and_lock_shared() {};
-		void unlock_upgrade_and_lock() {};
+		void unlock_upgrade_and_lock() {};
 
 
 		void lock_upgrade() {};
@@ -1,5 +1,6 @@
 // From https://github.com/HowardHinnant/upgrade_mutex
 // Modified: .cpp moved to .h
+//           try_lock_shared_barging added
 
 //---------------------------- upgrade_mutex.h ---------------------------------
 // 
@@ -183,6 +184,7 @@ swap(upgrade_lock<Mutex>&  x, upgrade_lock<Mutex>&  y);
 
 #include <chrono>
 #include <climits>
+#include <condition_variable>
 #include <mutex>
 #include <shared_mutex>
 #include <system_error>
@@ -277,6 +279,22 @@ public:
 		return false;
 	}
 
+    // Shared lock, which overtakes waiting writer; fails only if exclusively owned.
+    // For thread, which already holds shared locks - and writer may wait for them.
+    bool try_lock_shared_barging()
+	{
+		std::unique_lock<std::mutex> lk(mut_);
+		unsigned num_readers = state_ & n_readers_;
+		if ((num_readers != 0 || !(state_ & write_entered_)) && num_readers != n_readers_)
+		{
+			++num_readers;
+			state_ &= ~n_readers_;
+			state_ |= num_readers;
+			return true;
+		}
+		return false;
+	}
+
     template <class Rep, class Period>
         bool
         try_lock_shared_for(const std::chrono::duration<Rep, Period>& rel_time)
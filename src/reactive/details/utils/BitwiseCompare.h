@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+	#include <immintrin.h>
+	#define REACTIVE_UTILS_BITWISE_X86
+#endif
+
+namespace utils {
+
+	// Byte-wise comparison of memory blocks.
+	// x86 GCC/Clang: SSE2, AVX2 if CPU support it (checked once, at runtime). Otherwise - memcmp / byte loop.
+	// Return size, if blocks are equal.
+	namespace bitwise {
+		namespace details {
+			using Fn = std::size_t(*)(const unsigned char*, const unsigned char*, std::size_t);
+
+			inline std::size_t first_mismatch_bytes(const unsigned char* l, const unsigned char* r, std::size_t begin, std::size_t size) {
+				for (std::size_t i = begin; i < size; ++i) {
+					if (l[i] != r[i]) return i;
+				}
+				return size;
+			}
+			// return (index of last mismatch) + 1, or 0
+			inline std::size_t last_mismatch_bytes(const unsigned char* l, const unsigned char* r, std::size_t end) {
+				for (std::size_t i = end; i > 0; --i) {
+					if (l[i-1] != r[i-1]) return i;
+				}
+				return 0;
+			}
+
+			inline std::size_t first_mismatch_generic(const unsigned char* l, const unsigned char* r, std::size_t size) {
+				if (std::memcmp(l, r, size) == 0) return size;
+				return first_mismatch_bytes(l, r, 0, size);
+			}
+			inline std::size_t last_mismatch_generic(const unsigned char* l, const unsigned char* r, std::size_t size) {
+				return last_mismatch_bytes(l, r, size);
+			}
+
+#if defined(REACTIVE_UTILS_BITWISE_X86)
+			inline std::size_t first_mismatch_sse2(const unsigned char* l, const unsigned char* r, std::size_t size) {
+				std::size_t i = 0;
+				for (; i + 16 <= size; i += 16) {
+					const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l + i));
+					const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + i));
+					const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) ^ 0xFFFFu;
+					if (mask) return i + __builtin_ctz(mask);
+				}
+				return first_mismatch_bytes(l, r, i, size);
+			}
+			inline std::size_t last_mismatch_sse2(const unsigned char* l, const unsigned char* r, std::size_t size) {
+				std::size_t i = size;
+				for (; i >= 16; i -= 16) {
+					const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l + i - 16));
+					const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + i - 16));
+					const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) ^ 0xFFFFu;
+					if (mask) return i - 16 + (32 - __builtin_clz(mask));
+				}
+				return last_mismatch_bytes(l, r, i);
+			}
+
+			__attribute__((target("avx2")))
+			inline std::size_t first_mismatch_avx2(const unsigned char* l, const unsigned char* r, std::size_t size) {
+				std::size_t i = 0;
+				for (; i + 32 <= size; i += 32) {
+					const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + i));
+					const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i));
+					const unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+					if (mask) return i + __builtin_ctz(mask);
+				}
+				return first_mismatch_bytes(l, r, i, size);
+			}
+			__attribute__((target("avx2")))
+			inline std::size_t last_mismatch_avx2(const unsigned char* l, const unsigned char* r, std::size_t size) {
+				std::size_t i = size;
+				for (; i >= 32; i -= 32) {
+					const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + i - 32));
+					const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i - 32));
+					const unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+					if (mask) return i - 32 + (32 - __builtin_clz(mask));
+				}
+				return last_mismatch_bytes(l, r, i);
+			}
+
+			inline bool have_avx2() {
+				static const bool have = __builtin_cpu_supports("avx2");
+				return have;
+			}
+			inline Fn first_mismatch_fn() {
+				static const Fn fn = have_avx2() ? &first_mismatch_avx2 : &first_mismatch_sse2;
+				return fn;
+			}
+			inline Fn last_mismatch_fn() {
+				static const Fn fn = have_avx2() ? &last_mismatch_avx2 : &last_mismatch_sse2;
+				return fn;
+			}
+#else
+			inline Fn first_mismatch_fn() {
+				return &first_mismatch_generic;
+			}
+			inline Fn last_mismatch_fn() {
+				return &last_mismatch_generic;
+			}
+#endif
+		}
+
+		// index of first different byte, or size
+		inline std::size_t first_mismatch(const void* l, const void* r, std::size_t size) {
+			return details::first_mismatch_fn()(static_cast<const unsigned char*>(l), static_cast<const unsigned char*>(r), size);
+		}
+		// index of last different byte + 1, or 0
+		inline std::size_t last_mismatch(const void* l, const void* r, std::size_t size) {
+			return details::last_mismatch_fn()(static_cast<const unsigned char*>(l), static_cast<const unsigned char*>(r), size);
+		}
+		inline bool equal(const void* l, const void* r, std::size_t size) {
+			return first_mismatch(l, r, size) == size;
+		}
+	}
+
+}
@@ -0,0 +1,183 @@
+#ifndef REACTIVE_DETAILS_UTILS_ORDERSTATISTICTREE_H
+#define REACTIVE_DETAILS_UTILS_ORDERSTATISTICTREE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+namespace utils{
+
+    // Treap with subtree sizes: insert / erase / rank lookup in O(log n).
+    // Values unique by Less. Nodes in vector, freed ones reused.
+    template<class T, class Less>
+    class OrderStatisticTree{
+        using Index = std::uint32_t;
+        static constexpr Index nil = Index(-1);
+
+        struct Node{
+            T value;
+            std::uint32_t priority;
+            Index size  = 1;
+            Index left  = nil;
+            Index right = nil;
+        };
+
+        std::vector<Node> nodes;
+        std::vector<Index> free_nodes;
+        Index root = nil;
+        std::uint32_t seed = 0x9E3779B9u;
+        Less less;
+
+        std::uint32_t random(){
+            // xorshift32
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            return seed;
+        }
+
+        Index size(Index n) const{
+            return n == nil ? 0 : nodes[n].size;
+        }
+        void update(Index n){
+            nodes[n].size = 1 + size(nodes[n].left) + size(nodes[n].right);
+        }
+
+        // l - less than value, r - rest
+        void split(Index n, const T& value, Index& l, Index& r){
+            if (n == nil){
+                l = r = nil;
+                return;
+            }
+            if (less(nodes[n].value, value)){
+                split(nodes[n].right, value, nodes[n].right, r);
+                l = n;
+            } else {
+                split(nodes[n].left, value, l, nodes[n].left);
+                r = n;
+            }
+            update(n);
+        }
+
+        Index merge(Index l, Index r){
+            if (l == nil) return r;
+            if (r == nil) return l;
+            if (nodes[l].priority > nodes[r].priority){
+                nodes[l].right = merge(nodes[l].right, r);
+                update(l);
+                return l;
+            } else {
+                nodes[r].left = merge(l, nodes[r].left);
+                update(r);
+                return r;
+            }
+        }
+
+        // detach leftmost node of n, into first
+        Index pop_front(Index n, Index& first){
+            if (nodes[n].left == nil){
+                first = n;
+                return nodes[n].right;
+            }
+            nodes[n].left = pop_front(nodes[n].left, first);
+            update(n);
+            return n;
+        }
+
+        template<class Fn>
+        void foreach(Index n, Fn& fn) const{
+            if (n == nil) return;
+            foreach(nodes[n].left, fn);
+            fn(nodes[n].value);
+            foreach(nodes[n].right, fn);
+        }
+
+    public:
+        OrderStatisticTree(Less less = Less())
+            : less(std::move(less)) {}
+
+        std::size_t size() const{
+            return size(root);
+        }
+        bool empty() const{
+            return root == nil;
+        }
+
+        // count of values less than value
+        std::size_t rank(const T& value) const{
+            std::size_t rank = 0;
+            Index n = root;
+            while (n != nil){
+                if (less(nodes[n].value, value)){
+                    rank += size(nodes[n].left) + 1;
+                    n = nodes[n].right;
+                } else {
+                    n = nodes[n].left;
+                }
+            }
+            return rank;
+        }
+
+        const T& operator[](std::size_t rank) const{
+            Index n = root;
+            while (true){
+                const std::size_t left = size(nodes[n].left);
+                if (rank < left){
+                    n = nodes[n].left;
+                } else if (rank == left){
+                    return nodes[n].value;
+                } else {
+                    rank -= left + 1;
+                    n = nodes[n].right;
+                }
+            }
+        }
+
+        // returns rank of inserted
+        std::size_t insert(T value){
+            const std::size_t rank = this->rank(value);
+
+            Index node;
+            if (free_nodes.empty()){
+                node = Index(nodes.size());
+                nodes.push_back({std::move(value), random()});
+            } else {
+                node = free_nodes.back();
+                free_nodes.pop_back();
+                nodes[node] = {std::move(value), random()};
+            }
+
+            Index l, r;
+            split(root, nodes[node].value, l, r);
+            root = merge(merge(l, node), r);
+            return rank;
+        }
+
+        // value must be in tree. returns its rank
+        std::size_t erase(const T& value){
+            Index l, r, node;
+            split(root, value, l, r);
+            const std::size_t rank = size(l);
+            r = pop_front(r, node);
+            root = merge(l, r);
+            free_nodes.push_back(node);
+            return rank;
+        }
+
+        void clear(){
+            nodes.clear();
+            free_nodes.clear();
+            root = nil;
+        }
+
+        // in order
+        template<class Fn>
+        void foreach(Fn&& fn) const{
+            foreach(root, fn);
+        }
+    };
+
+}
+
+#endif //REACTIVE_DETAILS_UTILS_ORDERSTATISTICTREE_H
@@ -0,0 +1,104 @@
+#ifndef REACTIVE_DETAILS_UTILS_POINTERMAP_H
+#define REACTIVE_DETAILS_UTILS_POINTERMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+namespace utils{
+
+    // Open addressing (linear probing) map from non-null pointer to Value.
+    // Erase with backward shift - no tombstones. Capacity kept after erase / clear.
+    template<class Value>
+    class PointerMap{
+        struct Slot{
+            const void* key = nullptr;
+            Value value{};
+        };
+
+        std::vector<Slot> slots;
+        std::size_t m_size = 0;
+
+        std::size_t mask() const{
+            return slots.size() - 1;
+        }
+        std::size_t home(const void* key) const{
+            const std::uint64_t hash = std::uint64_t(reinterpret_cast<std::uintptr_t>(key)) * 0x9E3779B97F4A7C15ull;
+            return std::size_t(hash >> 32) & mask();
+        }
+
+        std::size_t find_slot(const void* key) const{
+            std::size_t i = home(key);
+            while (slots[i].key && slots[i].key != key) i = (i + 1) & mask();
+            return i;
+        }
+
+        void grow(){
+            std::vector<Slot> old(slots.empty() ? 16 : slots.size() * 2);
+            old.swap(slots);
+            for (Slot& slot : old){
+                if (!slot.key) continue;
+                slots[find_slot(slot.key)] = std::move(slot);
+            }
+        }
+
+    public:
+        std::size_t size() const{
+            return m_size;
+        }
+        bool empty() const{
+            return m_size == 0;
+        }
+
+        Value* find(const void* key){
+            if (m_size == 0) return nullptr;
+            Slot& slot = slots[find_slot(key)];
+            return slot.key ? &slot.value : nullptr;
+        }
+
+        // false, if key already exists (value unchanged)
+        bool insert(const void* key, Value value){
+            if ((m_size + 1) * 2 > slots.size()) grow();
+
+            Slot& slot = slots[find_slot(key)];
+            if (slot.key) return false;
+
+            slot.key   = key;
+            slot.value = std::move(value);
+            ++m_size;
+            return true;
+        }
+
+        void erase(const void* key){
+            if (m_size == 0) return;
+            std::size_t i = find_slot(key);
+            if (!slots[i].key) return;
+
+            // shift back following entries, which probe sequence passes i
+            std::size_t j = i;
+            while (true){
+                j = (j + 1) & mask();
+                if (!slots[j].key) break;
+
+                const std::size_t k = home(slots[j].key);
+                const bool stays = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+                if (stays) continue;
+
+                slots[i] = std::move(slots[j]);
+                i = j;
+            }
+            slots[i].key = nullptr;
+            --m_size;
+        }
+
+        void clear(){
+            if (m_size == 0) return;
+            for (Slot& slot : slots) slot.key = nullptr;
+            m_size = 0;
+        }
+    };
+
+}
+
+#endif //REACTIVE_DETAILS_UTILS_POINTERMAP_H
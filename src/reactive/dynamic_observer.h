@@ -0,0 +1,210 @@
+#ifndef REACTIVE_DYNAMIC_OBSERVER_H
+#define REACTIVE_DYNAMIC_OBSERVER_H
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <cassert>
+#include <condition_variable>
+
+#include "details/threading/SpinLock.h"
+#include "details/Delegate.h"
+#include "details/Pointer.h"
+#include "Subscription.h"
+
+namespace reactive{
+
+    namespace details{
+        namespace DynamicObserver {
+
+            // Homogeneous fan-in over runtime-sized list of observables.
+            //
+            // Weak pointers and values stored contiguously, slot per observable.
+            // Incoming values are queued as dirty slots (bitmap deduplicates, index list makes it O(1) per change).
+            // Dirty slots drained by one thread at a time - closure never called concurrently.
+            // If change arrives while closure runs (other thread, or from the closure itself),
+            // it will be applied by the running thread, before it returns.
+            // Created draining - changes during subscription queued, until start() or first execute().
+            //
+            // closure(std::size_t index, const Value& old_value, const Value& new_value)
+            template<class Closure, class ObservablePtr>
+            class Observer {
+                using Observable = element_t<ObservablePtr>;
+                using Lock = threading::SpinLock<threading::SpinLockMode::Adaptive>;
+                using Word = std::uint64_t;
+                static constexpr const std::size_t word_bits = sizeof(Word) * 8;
+            public:
+                using Value = typename Observable::Value;
+            private:
+                Lock lock;
+                bool unsubscribed = false;
+                bool draining = true;                   // until start() / first execute()
+                bool started  = false;
+                std::size_t execute_waiting = 0;        // drainer hands over to execute() - it can't starve
+                std::condition_variable_any drained;
+
+                std::vector<Value> values;              // last values, passed to closure
+                std::vector<Value> pending_values;      // last received values, valid for dirty slots only
+                std::vector<Word> dirty;
+                std::vector<std::size_t> dirty_list;
+
+                std::decay_t<Closure> closure;
+            public:
+                DelegateTag tag;
+                std::vector<weak_t<ObservablePtr>> observable_weak_ptrs;     // const after construction
+
+                template<class ClosureT>
+                Observer(ClosureT&& closure, const std::vector<ObservablePtr>& observables)
+                    : closure(std::forward<ClosureT>(closure))
+                {
+                    const std::size_t size = observables.size();
+                    observable_weak_ptrs.reserve(size);
+                    values.reserve(size);
+                    for (const auto& observable : observables) {
+                        observable_weak_ptrs.emplace_back(observable);
+                        values.emplace_back(observable->getCopy());
+                    }
+                    pending_values = values;
+                    dirty.resize((size + word_bits - 1) / word_bits, 0);
+                }
+
+                std::size_t size() const {
+                    return values.size();
+                }
+
+            private:
+                // lock must be locked. Return with lock locked.
+                void drain(std::unique_lock<Lock>& l) {
+                    while (!dirty_list.empty()) {
+                        // rest drained by execute(), after its closure
+                        if (execute_waiting) break;
+
+                        const std::size_t index = dirty_list.back();
+                        dirty_list.pop_back();
+                        dirty[index / word_bits] &= ~(Word(1) << (index % word_bits));
+
+                        Value new_value = pending_values[index];
+                        l.unlock();
+                            // values touched only by drainer
+                            closure(index, static_cast<const Value&>(values[index]), static_cast<const Value&>(new_value));
+                            values[index] = std::move(new_value);
+                        l.lock();
+                    }
+                    draining = false;
+                    if (execute_waiting) drained.notify_all();
+                }
+
+            public:
+                // after subscribed - value may be changed before subscription
+                void refresh(std::size_t index, Value&& value) {
+                    std::unique_lock<Lock> l(lock);
+                    values[index] = std::move(value);
+                }
+                void start() {
+                    std::unique_lock<Lock> l(lock);
+                    started = true;
+                    drain(l);
+                }
+
+                template<class Arg>
+                void run(std::size_t index, Arg&& arg) {
+                    std::unique_lock<Lock> l(lock);
+                    if (unsubscribed) return;
+
+                    pending_values[index] = std::forward<Arg>(arg);
+
+                    Word& word = dirty[index / word_bits];
+                    const Word bit = Word(1) << (index % word_bits);
+                    if (!(word & bit)) {
+                        word |= bit;
+                        dirty_list.push_back(index);
+                    }
+
+                    if (draining) return;
+                    draining = true;
+                    drain(l);
+                }
+
+                // closure(const std::vector<Value>& values)
+                // called exclusively with drain. Changes that came during the call, applied right after.
+                template<class ClosureT>
+                void execute(ClosureT&& closure) {
+                    std::unique_lock<Lock> l(lock);
+                    if (!started) {
+                        started = true;                 // takes over initial drain
+                    } else if (draining) {
+                        ++execute_waiting;
+                        drained.wait(l, [&]() { return !draining; });
+                        --execute_waiting;
+                    }
+                    draining = true;
+                    l.unlock();
+                        closure(static_cast<const std::vector<Value>&>(values));
+                    l.lock();
+                    drain(l);
+                }
+
+                void unsubscribe() {
+                    std::unique_lock<Lock> l(lock);
+                    if (unsubscribed) return;
+
+                    for (auto& observable : observable_weak_ptrs) {
+                        auto ptr = observable.lock();
+                        if (!ptr) continue;
+
+                        *ptr -= tag;
+                    }
+
+                    unsubscribed = true;
+                }
+            };
+
+
+            template<class Closure, class ObservableHandle>
+            auto observe_impl(Closure&& closure, const std::vector<ObservableHandle>& observables) {
+                using SharedPtr  = std::decay_t<decltype(std::declval<const ObservableHandle&>().shared_ptr())>;
+                using Observer   = Observer<Closure, SharedPtr>;
+
+                std::vector<SharedPtr> observable_ptrs;
+                observable_ptrs.reserve(observables.size());
+                for (const auto& observable : observables) {
+                    assert(observable && "all observables must exists on observe_each()!");
+                    observable_ptrs.emplace_back(observable.shared_ptr());
+                }
+
+                using ObserverPointer = pointer_for<element_t<SharedPtr>::threadsafe>;
+                auto observer = ObserverPointer::template make_shared<Observer>(
+                    std::forward<Closure>(closure), observable_ptrs
+                );
+
+                for (std::size_t i = 0; i < observable_ptrs.size(); ++i) {
+                    observable_ptrs[i]->subscribe(observer->tag, [observer, i](auto&& arg) {
+                        observer->run(i, std::forward<decltype(arg)>(arg));
+                    });
+                }
+                for (std::size_t i = 0; i < observable_ptrs.size(); ++i) {
+                    observer->refresh(i, observable_ptrs[i]->getCopy());
+                }
+
+                // caller must start() or execute()
+                return observer;
+            }
+
+        }   // namespace DynamicObserver
+    }   // namespace details
+
+
+    // closure(std::size_t index, const Value& old_value, const Value& new_value)
+    template<class Closure, class Observable>
+    Subscription observe_each(Closure&& closure, const std::vector<Observable>& observables){
+        auto observer = details::DynamicObserver::observe_impl(std::forward<Closure>(closure), observables);
+        observer->start();
+        return [observer](){
+            observer->unsubscribe();
+        };
+    }
+
+}
+
+#endif //REACTIVE_DYNAMIC_OBSERVER_H
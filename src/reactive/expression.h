@@ -0,0 +1,255 @@
+#ifndef REACTIVE_EXPRESSION_H
+#define REACTIVE_EXPRESSION_H
+
+#include <tuple>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+namespace reactive{
+
+	class ExpressionBase {};
+	class ObservablePropertyBase;
+	class ReactivePropertyBase;
+
+	namespace details{
+	namespace expression{
+		template<class T>
+		using is_expression = std::is_base_of<ExpressionBase, std::decay_t<T>>;
+
+		// ObservableProperty / ReactiveProperty handles only (tagged by base) -
+		// not anything with shared_ptr() and Value (maps, vectors, array elements...)
+		template<class T>
+		using is_property = std::integral_constant<bool,
+			std::is_base_of<ObservablePropertyBase, std::decay_t<T>>::value
+			|| std::is_base_of<ReactivePropertyBase, std::decay_t<T>>::value
+		>;
+
+
+		// Stands in place of property in stored (evaluated) expression.
+		// Evaluated expression does not hold observables - no shared_ptr cycles.
+		struct Placeholder : ExpressionBase {
+			static constexpr const std::size_t leaf_count = 1;
+
+			template<std::size_t offset, class Values>
+			decltype(auto) eval(const Values& values) const {
+				return std::get<offset>(values);
+			}
+		};
+
+		template<class SharedPtr>
+		struct Leaf : ExpressionBase {
+			static constexpr const std::size_t leaf_count = 1;
+			SharedPtr ptr;
+
+			Leaf(const SharedPtr& ptr)
+				: ptr(ptr) {}
+
+			auto leaves() const {
+				return std::make_tuple(ptr);
+			}
+			Placeholder strip() const {
+				return {};
+			}
+		};
+
+		template<class T>
+		struct Constant : ExpressionBase {
+			static constexpr const std::size_t leaf_count = 0;
+			T value;
+
+			template<class Arg>
+			Constant(Arg&& arg)
+				: value(std::forward<Arg>(arg)) {}
+
+			auto leaves() const {
+				return std::tuple<>{};
+			}
+			const Constant& strip() const {
+				return *this;
+			}
+
+			template<std::size_t offset, class Values>
+			const T& eval(const Values&) const {
+				return value;
+			}
+		};
+
+		template<class Op, class E>
+		struct Unary : ExpressionBase {
+			static constexpr const std::size_t leaf_count = E::leaf_count;
+			E e;
+
+			Unary(const E& e)
+				: e(e) {}
+
+			auto leaves() const {
+				return e.leaves();
+			}
+			auto strip() const {
+				using Stripped = std::decay_t<decltype(e.strip())>;
+				return Unary<Op, Stripped>{ e.strip() };
+			}
+
+			template<std::size_t offset, class Values>
+			auto eval(const Values& values) const {
+				return Op{}(e.template eval<offset>(values));
+			}
+		};
+
+		template<class Op, class L, class R>
+		struct Binary : ExpressionBase {
+			static constexpr const std::size_t leaf_count = L::leaf_count + R::leaf_count;
+			L l;
+			R r;
+
+			Binary(const L& l, const R& r)
+				: l(l)
+				, r(r) {}
+
+			auto leaves() const {
+				return std::tuple_cat(l.leaves(), r.leaves());
+			}
+			auto strip() const {
+				using LStripped = std::decay_t<decltype(l.strip())>;
+				using RStripped = std::decay_t<decltype(r.strip())>;
+				return Binary<Op, LStripped, RStripped>{ l.strip(), r.strip() };
+			}
+
+			template<std::size_t offset, class Values>
+			auto eval(const Values& values) const {
+				return Op{}(l.template eval<offset>(values), r.template eval<offset + L::leaf_count>(values));
+			}
+		};
+
+
+		template<class T>
+		auto as_expression(const T& property, std::true_type is_property, std::false_type is_expression) {
+			using SharedPtr = std::decay_t<decltype(property.shared_ptr())>;
+			return Leaf<SharedPtr>{ property.shared_ptr() };
+		}
+		template<class T>
+		const T& as_expression(const T& expression, std::false_type is_property, std::true_type is_expression) {
+			return expression;
+		}
+		template<class T>
+		auto as_expression(const T& value, std::false_type is_property, std::false_type is_expression) {
+			return Constant<T>{ value };
+		}
+		template<class T>
+		auto as_expression(const T& any) {
+			return as_expression(any, is_property<T>{}, is_expression<T>{});
+		}
+
+		template<class T>
+		using as_expression_t = std::decay_t<decltype(as_expression(std::declval<const T&>()))>;
+
+
+		template<class T>
+		using is_operand = std::integral_constant<bool, is_property<T>::value || is_expression<T>::value>;
+
+		template<class L, class R>
+		using enable_binary = std::enable_if_t<is_operand<L>::value || is_operand<R>::value>;
+
+
+		template<class Op, class L, class R>
+		auto make_binary(const L& l, const R& r) {
+			return Binary<Op, as_expression_t<L>, as_expression_t<R>>{ as_expression(l), as_expression(r) };
+		}
+		template<class Op, class E>
+		auto make_unary(const E& e) {
+			return Unary<Op, as_expression_t<E>>{ as_expression(e) };
+		}
+
+
+		template<class F, class Tuple, std::size_t... I>
+		static decltype(auto) apply_impl(F &&f, Tuple &&t, std::index_sequence<I...>) {
+			return f(std::get<I>(std::forward<Tuple>(t))...);
+		}
+		template<class F, class Tuple>
+		static decltype(auto) apply(F &&f, Tuple &&t) {
+			return expression::apply_impl(std::forward<F>(f), std::forward<Tuple>(t),
+				std::make_index_sequence<std::tuple_size<std::decay_t<Tuple>>::value>{});
+		}
+
+		// closure(values...) for observe - whole expression as one node
+		template<class Expression>
+		auto make_closure(const Expression& expression) {
+			return [stripped = expression.strip()](const auto&... values) {
+				return stripped.template eval<0>(std::forward_as_tuple(values...));
+			};
+		}
+
+		// observables.shared_ptr()... of expression
+		template<class Expression, class Closure>
+		decltype(auto) apply_leaves(const Expression& expression, Closure&& closure) {
+			return expression::apply(std::forward<Closure>(closure), expression.leaves());
+		}
+
+		// value type of expression
+		template<class Expression>
+		struct result {
+			template<class ...SharedPtrs>
+			static auto get(const std::tuple<SharedPtrs...>&)
+				-> std::decay_t<decltype(std::declval<const Expression&>().strip().template eval<0>(
+					std::declval<std::tuple<const typename SharedPtrs::element_type::Value&...>>()
+				))>;
+
+			using type = decltype(get(std::declval<const Expression&>().leaves()));
+		};
+		template<class Expression>
+		using result_t = typename result<Expression>::type;
+	}
+	}
+
+
+	// Arithmetic on ObservableProperty / ReactiveProperty build expression.
+	// Expression evaluated in one reactive node, see ReactiveProperty::set(expression).
+	// ==, != and ! intentionally not overloaded (handles are convertible to bool).
+
+	template<class L, class R, class = details::expression::enable_binary<L, R>>
+	auto operator+(const L& l, const R& r) {
+		return details::expression::make_binary<std::plus<>>(l, r);
+	}
+	template<class L, class R, class = details::expression::enable_binary<L, R>>
+	auto operator-(const L& l, const R& r) {
+		return details::expression::make_binary<std::minus<>>(l, r);
+	}
+	template<class L, class R, class = details::expression::enable_binary<L, R>>
+	auto operator*(const L& l, const R& r) {
+		return details::expression::make_binary<std::multiplies<>>(l, r);
+	}
+	template<class L, class R, class = details::expression::enable_binary<L, R>>
+	auto operator/(const L& l, const R& r) {
+		return details::expression::make_binary<std::divides<>>(l, r);
+	}
+	template<class L, class R, class = details::expression::enable_binary<L, R>>
+	auto operator%(const L& l, const R& r) {
+		return details::expression::make_binary<std::modulus<>>(l, r);
+	}
+
+	template<class L, class R, class = details::expression::enable_binary<L, R>>
+	auto operator<(const L& l, const R& r) {
+		return details::expression::make_binary<std::less<>>(l, r);
+	}
+	template<class L, class R, class = details::expression::enable_binary<L, R>>
+	auto operator>(const L& l, const R& r) {
+		return details::expression::make_binary<std::greater<>>(l, r);
+	}
+	template<class L, class R, class = details::expression::enable_binary<L, R>>
+	auto operator<=(const L& l, const R& r) {
+		return details::expression::make_binary<std::less_equal<>>(l, r);
+	}
+	template<class L, class R, class = details::expression::enable_binary<L, R>>
+	auto operator>=(const L& l, const R& r) {
+		return details::expression::make_binary<std::greater_equal<>>(l, r);
+	}
+
+	template<class E, class = std::enable_if_t<details::expression::is_operand<E>::value>>
+	auto operator-(const E& e) {
+		return details::expression::make_unary<std::negate<>>(e);
+	}
+
+}
+
+#endif //REACTIVE_EXPRESSION_H
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "ptr.h"
+#include "../ObservableProperty.h"
+
+namespace reactive {
+namespace intrusive {
+
+	// ObservableProperty, which owns data through intrusive::shared_ptr
+	template<class T, class blocking_class = default_blocking, class change_detection_policy = reactive::change_detection::equal>
+	using ObservableProperty = reactive::ObservableProperty<T, blocking_class, true, change_detection_policy, pointer<true>>;
+
+}
+}
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+namespace reactive {
+namespace intrusive {
+
+	namespace details {
+		template<bool atomic>
+		using Counter = std::conditional_t<atomic, std::atomic<std::uint32_t>, std::uint32_t>;
+
+		inline void increment(std::atomic<std::uint32_t>& counter) {
+			counter.fetch_add(1, std::memory_order_relaxed);
+		}
+		inline void increment(std::uint32_t& counter) {
+			++counter;
+		}
+		// returns true, if it was last
+		inline bool decrement(std::atomic<std::uint32_t>& counter) {
+			return counter.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		}
+		inline bool decrement(std::uint32_t& counter) {
+			return --counter == 0;
+		}
+		// increment if not zero
+		inline bool increment_nonzero(std::atomic<std::uint32_t>& counter) {
+			std::uint32_t count = counter.load(std::memory_order_relaxed);
+			while (count != 0) {
+				if (counter.compare_exchange_weak(count, count + 1, std::memory_order_acquire, std::memory_order_relaxed)) return true;
+			}
+			return false;
+		}
+		inline bool increment_nonzero(std::uint32_t& counter) {
+			if (counter == 0) return false;
+			++counter;
+			return true;
+		}
+		inline std::uint32_t load(const std::atomic<std::uint32_t>& counter) {
+			return counter.load(std::memory_order_relaxed);
+		}
+		inline std::uint32_t load(std::uint32_t counter) {
+			return counter;
+		}
+
+		// Counters and object in one allocation. weak - weak pointers + 1 for all strong.
+		template<class T, bool atomic>
+		struct Block {
+			Counter<atomic> strong{ 1 };
+			Counter<atomic> weak{ 1 };
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+			T* get() {
+				return reinterpret_cast<T*>(&storage);
+			}
+
+			void release_strong() {
+				if (!decrement(strong)) return;
+				get()->~T();
+				release_weak();
+			}
+			void release_weak() {
+				if (decrement(weak)) delete this;
+			}
+		};
+	}
+
+	template<class T, bool atomic>
+	class weak_ptr;
+
+	// Single allocation shared pointer, size of one pointer. atomic = false - plain integer counters, single thread only.
+	// No aliasing / conversions - pointer to exactly T.
+	template<class T, bool atomic = true>
+	class shared_ptr {
+		template<class, bool> friend class shared_ptr;
+		template<class, bool> friend class weak_ptr;
+		template<class U, bool a, class ...Args>
+		friend shared_ptr<U, a> make_shared(Args&&...args);
+
+		using Block = details::Block<T, atomic>;
+		Block* block = nullptr;
+
+		// takes ownership of one strong reference
+		explicit shared_ptr(Block* block)
+			: block(block) {}
+	public:
+		using element_type = T;
+		using weak_type    = weak_ptr<T, atomic>;
+
+		shared_ptr() = default;
+		shared_ptr(std::nullptr_t) {}
+
+		shared_ptr(const shared_ptr& other)
+			: block(other.block)
+		{
+			if (block) details::increment(block->strong);
+		}
+		shared_ptr(shared_ptr&& other) noexcept
+			: block(other.block)
+		{
+			other.block = nullptr;
+		}
+		shared_ptr& operator=(shared_ptr other) noexcept {
+			std::swap(block, other.block);
+			return *this;
+		}
+
+		~shared_ptr() {
+			if (block) block->release_strong();
+		}
+
+		void reset() {
+			shared_ptr().swap(*this);
+		}
+		void swap(shared_ptr& other) noexcept {
+			std::swap(block, other.block);
+		}
+
+		T* get() const {
+			return block ? block->get() : nullptr;
+		}
+		// not null
+		T* operator->() const {
+			return block->get();
+		}
+		T& operator*() const {
+			return *block->get();
+		}
+		explicit operator bool() const {
+			return block != nullptr;
+		}
+
+		long use_count() const {
+			return block ? long(details::load(block->strong)) : 0;
+		}
+
+		const void* owner() const {
+			return block;
+		}
+		template<class Other>
+		bool owner_before(const Other& other) const {
+			return std::less<const void*>{}(owner(), other.owner());
+		}
+
+		bool operator==(const shared_ptr& other) const {
+			return block == other.block;
+		}
+		bool operator!=(const shared_ptr& other) const {
+			return block != other.block;
+		}
+	};
+
+	template<class T, bool atomic = true>
+	class weak_ptr {
+		using Block = details::Block<T, atomic>;
+		Block* block = nullptr;
+	public:
+		using element_type = T;
+
+		weak_ptr() = default;
+		weak_ptr(const shared_ptr<T, atomic>& shared)
+			: block(shared.block)
+		{
+			if (block) details::increment(block->weak);
+		}
+		weak_ptr(const weak_ptr& other)
+			: block(other.block)
+		{
+			if (block) details::increment(block->weak);
+		}
+		weak_ptr(weak_ptr&& other) noexcept
+			: block(other.block)
+		{
+			other.block = nullptr;
+		}
+		weak_ptr& operator=(weak_ptr other) noexcept {
+			std::swap(block, other.block);
+			return *this;
+		}
+
+		~weak_ptr() {
+			if (block) block->release_weak();
+		}
+
+		shared_ptr<T, atomic> lock() const {
+			if (block && details::increment_nonzero(block->strong)) return shared_ptr<T, atomic>(block);
+			return {};
+		}
+		bool expired() const {
+			return !block || details::load(block->strong) == 0;
+		}
+
+		const void* owner() const {
+			return block;
+		}
+		template<class Other>
+		bool owner_before(const Other& other) const {
+			return std::less<const void*>{}(owner(), other.owner());
+		}
+	};
+
+	template<class T, bool atomic = true, class ...Args>
+	shared_ptr<T, atomic> make_shared(Args&&...args) {
+		using Block = details::Block<T, atomic>;
+		Block* block = new Block;
+		try {
+			new (block->get()) T(std::forward<Args>(args)...);
+		} catch (...) {
+			delete block;
+			throw;
+		}
+		return shared_ptr<T, atomic>(block);
+	}
+
+
+	// pointer family for property handles, see ObservableProperty / ReactiveProperty
+	template<bool atomic = true>
+	struct pointer {
+		template<class T>
+		using shared_ptr = intrusive::shared_ptr<T, atomic>;
+		template<class T>
+		using weak_ptr = intrusive::weak_ptr<T, atomic>;
+
+		template<class T, class ...Args>
+		static shared_ptr<T> make_shared(Args&&...args) {
+			return intrusive::make_shared<T, atomic>(std::forward<Args>(args)...);
+		}
+	};
+
+}
+}
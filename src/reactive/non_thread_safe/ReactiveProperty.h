@@ -1,12 +1,13 @@
 #pragma once
 
 #include "../ReactiveProperty.h"
+#include "../intrusive/ptr.h"
 
 namespace reactive {
 namespace non_thread_safe {
 
-	template<class T>
-	using ReactiveProperty = reactive::ReactiveProperty<T, reactive::blocking, false>;
+	template<class T, class change_detection_policy = reactive::change_detection::equal>
+	using ReactiveProperty = reactive::ReactiveProperty<T, reactive::blocking, false, change_detection_policy, intrusive::pointer<false>>;
 
 }
 }
\ No newline at end of file
@@ -6,12 +6,21 @@
 #include <mutex>
 #include <tuple>
 #include <utility>
+#include <array>
+#include <algorithm>
 #include <cassert>
 
 #include "details/threading/SpinLock.h"
+#include "details/threading/ValueSlots.h"
+#include "details/threading/details/SpinLockSpinner.h"
 #include "details/Delegate.h"
+#include "details/Snapshot.h"
+#include "details/HeldSharedLocks.h"
+#include "details/Transaction.h"
+#include "details/Pointer.h"
 
 #include "blocking.h"
+#include "Subscription.h"
 
 namespace reactive{
 
@@ -40,7 +49,7 @@ namespace reactive{
 			}
 			template<class F, class Tuple>
 			static constexpr decltype(auto) apply(F &&f, Tuple &&t) {
-				return apply_impl(std::forward<F>(f), std::forward<Tuple>(t),
+				return reactive::details::MultiObserver::apply_impl(std::forward<F>(f), std::forward<Tuple>(t),
 					std::make_index_sequence<std::tuple_size<std::decay_t<Tuple>>::value>{});
 			}
 
@@ -51,14 +60,14 @@ namespace reactive{
                 }, tuple);
             }
 
-            template<class ...Objs, std::size_t ...Is>
-            static auto lockWeakPtrs(const std::tuple<std::weak_ptr<Objs>...> &tuple, std::index_sequence<Is...>) {
+            template<class ...WeakPtrs, std::size_t ...Is>
+            static auto lockWeakPtrs(const std::tuple<WeakPtrs...> &tuple, std::index_sequence<Is...>) {
                 return std::make_tuple(std::get<Is>(tuple).lock()...);
             }
 
-            template<class ...Objs>
-            static auto lockWeakPtrs(const std::tuple<std::weak_ptr<Objs>...> &tuple) {
-                return lockWeakPtrs(tuple, std::make_index_sequence<sizeof...(Objs)>{});
+            template<class ...WeakPtrs>
+            static auto lockWeakPtrs(const std::tuple<WeakPtrs...> &tuple) {
+                return lockWeakPtrs(tuple, std::make_index_sequence<sizeof...(WeakPtrs)>{});
             }
 
 
@@ -76,7 +85,8 @@ namespace reactive{
 			}
 
 
-            template<class Closure, class ...Observables>
+            // ObservablePtrs - shared pointers to observables (std::shared_ptr / intrusive::shared_ptr)
+            template<class Closure, class ...ObservablePtrs>
             class ObserverBase {
             protected:
                 bool unsubscribed = false;
@@ -84,12 +94,12 @@ namespace reactive{
                 using Lock = threading::SpinLock<threading::SpinLockMode::Adaptive>;
                 Lock lock;
             public:
-                using ObservablesTuple = std::tuple<std::weak_ptr<Observables>...>;
+                using ObservablesTuple = std::tuple<weak_t<ObservablePtrs>...>;
                 ObservablesTuple observable_weak_ptrs;
 
 				DelegateTag tag;
 
-                ObserverBase(const std::shared_ptr<Observables>&... observables)
+                ObserverBase(const ObservablePtrs&... observables)
                         : observable_weak_ptrs(observables...) {}
 
                 void unsubscribe() {
@@ -105,11 +115,114 @@ namespace reactive{
 
                     unsubscribed = true;
                 }
+
+                bool is_unsubscribed() {
+                    std::unique_lock<Lock> l(lock);
+                    return unsubscribed;
+                }
+            };
+
+            // Shared locks of blocking observables, acquired in global (address) order.
+            // Locks already held by this thread (trigger, outer observer) skipped.
+            // Nothing held by this thread - blocking acquisition, ordered, can't deadlock with other observers.
+            // Otherwise (called from event, held lock is out of order) - barging try-lock all (do not wait for writers,
+            // which may wait for our held locks), on fail release and back off. Fail only while property exclusively owned,
+            // and writer does not wait for anything while it owns property.
+            template<std::size_t N>
+            class OrderedSharedLock {
+                struct Entry {
+                    const void* address;        // shared_lock_id()
+                    const void* observable;
+                    bool (*try_lock)(const void*);
+                    void (*lock)(const void*);
+                    void (*unlock)(const void*);
+
+                    bool operator<(const Entry& other) const {
+                        return std::less<const void*>{}(address, other.address);
+                    }
+                };
+                template<class Observable>
+                struct Ops {
+                    static bool try_lock(const void* ptr) {
+                        return static_cast<const Observable*>(ptr)->try_lock_shared_barging();
+                    }
+                    static void lock(const void* ptr) {
+                        static_cast<const Observable*>(ptr)->lock_shared();
+                    }
+                    static void unlock(const void* ptr) {
+                        static_cast<const Observable*>(ptr)->unlock_shared();
+                    }
+                };
+
+                std::array<Entry, N> entries;
+                std::size_t count = 0;
+
+                void unlock_first(std::size_t n) {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        entries[i].unlock(entries[i].observable);
+                    }
+                }
+                bool try_lock_all() {
+                    for (std::size_t i = 0; i < count; ++i) {
+                        if (!entries[i].try_lock(entries[i].observable)) {
+                            unlock_first(i);
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                template<class Observable>
+                void add(const Observable& observable, std::true_type is_blocking) {
+                    entries[count++] = { observable.shared_lock_id(), &observable, &Ops<Observable>::try_lock, &Ops<Observable>::lock, &Ops<Observable>::unlock };
+                }
+                template<class Observable>
+                void add(const Observable&, std::false_type is_blocking) {}
+            public:
+                template<class Observable>
+                void add(const Observable& observable) {
+                    add(observable, std::integral_constant<bool, std::is_same<typename Observable::blocking_mode, blocking>::value>{});
+                }
+
+                void lock() {
+                    if (count == 0) return;
+
+                    std::sort(entries.begin(), entries.begin() + count);
+                    count = std::unique(entries.begin(), entries.begin() + count, [](const Entry& l, const Entry& r) {
+                        return l.address == r.address;
+                    }) - entries.begin();
+
+                    auto& held = held_shared_locks();
+                    if (!held.empty()) {
+                        count = std::remove_if(entries.begin(), entries.begin() + count, [](const Entry& entry) {
+                            return is_shared_lock_held(entry.address);
+                        }) - entries.begin();
+                    }
+
+                    if (held.empty()) {
+                        for (std::size_t i = 0; i < count; ++i) {
+                            entries[i].lock(entries[i].observable);
+                        }
+                    } else if (!try_lock_all()) {
+                        threading::details::SpinLockSpinner::spinWhile([&]() { return !try_lock_all(); });
+                    }
+
+                    for (std::size_t i = 0; i < count; ++i) {
+                        held.push_back(entries[i].address);
+                    }
+                }
+
+                ~OrderedSharedLock() {
+                    auto& held = held_shared_locks();
+                    held.resize(held.size() - count);
+                    unlock_first(count);
+                }
             };
 
-            template<bool add_unsubscibe_self, class Closure, class ...Observables>
-            class ObserverBlocking : public ObserverBase<Closure, Observables...> {
-                using Base = ObserverBase<Closure, Observables...>;
+
+            template<bool add_unsubscibe_self, class Closure, class ...ObservablePtrs>
+            class ObserverBlocking : public ObserverBase<Closure, ObservablePtrs...> {
+                using Base = ObserverBase<Closure, ObservablePtrs...>;
             public:
                 using Base::observable_weak_ptrs;
                 using Base::unsubscribe;
@@ -117,30 +230,91 @@ namespace reactive{
                 std::decay_t<Closure> closure;
 
                 template<class ClosureT>
-                ObserverBlocking(ClosureT &&closure, const std::shared_ptr<Observables> &... observables)
+                ObserverBlocking(ClosureT &&closure, const ObservablePtrs&... observables)
                         : Base(observables...)
                         , closure(std::forward<ClosureT>(closure)) {}
 
+                // Triggering observable is alive (its event calls us), and arg is its current value
+                // (for blocking observable - under its read lock). Lock only other observables, see OrderedSharedLock.
                 template<class IntegralConstant, class Arg>
-                void run(IntegralConstant, Arg &&) {
-                    execute();
+                void run(IntegralConstant, Arg &&arg) {
+                    run_impl<IntegralConstant::value>(arg, std::index_sequence_for<ObservablePtrs...>{});
                 }
 
+                // remember arg, for deferred execute() (nothing to remember - execute() read observables)
+                template<class IntegralConstant, class Arg>
+                void cache(IntegralConstant, Arg &&) {}
+
                 void execute(){
                     execute(closure);
                 }
 
             private:
+                template<class Arg>
+                struct ArgRef {
+                    const Arg& arg;
+                    const Arg& get() const {
+                        return arg;
+                    }
+                };
+
+                template<std::size_t I, std::size_t J>
+                auto lock_other(std::true_type is_trigger) {
+                    return std::tuple_element_t<J, std::tuple<ObservablePtrs...>>{};
+                }
+                template<std::size_t I, std::size_t J>
+                auto lock_other(std::false_type is_trigger) {
+                    return std::get<J>(observable_weak_ptrs).lock();
+                }
+
+                template<class Arg, class SharedPtr>
+                static auto read_lock(const Arg& arg, const SharedPtr&, std::true_type is_trigger) {
+                    return ArgRef<Arg>{ arg };
+                }
+                template<class Arg, class SharedPtr>
+                static auto read_lock(const Arg&, const SharedPtr& ptr, std::false_type is_trigger) {
+                    return ptr->read_locked();
+                }
+
+                template<class Locks, class SharedPtr>
+                static void add_lock(Locks&, const SharedPtr&, std::true_type is_trigger) {}
+                template<class Locks, class SharedPtr>
+                static void add_lock(Locks& locks, const SharedPtr& ptr, std::false_type is_trigger) {
+                    locks.add(*ptr);
+                }
+
+                template<std::size_t I, class Arg, std::size_t ...Js>
+                void run_impl(const Arg& arg, std::index_sequence<Js...>) {
+                    auto shared_ptrs = std::make_tuple(lock_other<I, Js>(std::integral_constant<bool, I == Js>{})...);
+                    const bool all_locked = and_all( (I == Js || std::get<Js>(shared_ptrs))... );
+
+                    if (!all_locked) {
+                        // can't be reactive further, unsubscribe
+                        unsubscribe();
+                        return;
+                    }
+
+                    OrderedSharedLock<sizeof...(ObservablePtrs)> ordered_lock;
+                    (void)std::initializer_list<int>{ (add_lock(ordered_lock, std::get<Js>(shared_ptrs), std::integral_constant<bool, I == Js>{}), 0)... };
+                    ordered_lock.lock();
+
+                    auto observable_locks = std::make_tuple(
+                        read_lock(arg, std::get<Js>(shared_ptrs), std::integral_constant<bool, I == Js>{})...
+                    );
+
+                    apply_closure(closure, observable_locks, std::integral_constant<bool, add_unsubscibe_self>{});
+                }
+
                 template<class ClosureT, class ObservableLocks>
                 void apply_closure(ClosureT&& closure, ObservableLocks& observable_locks, std::false_type){
                     reactive::details::MultiObserver::apply([&](auto &... locks) {
-                        closure(locks.get()...);
+                        closure(reactive::details::unwrap(locks.get())...);
                     }, observable_locks);
                 }
                 template<class ClosureT, class ObservableLocks>
                 void apply_closure(ClosureT&& closure, ObservableLocks& observable_locks, std::true_type){
                     reactive::details::MultiObserver::apply([&](auto &... locks) {
-                        closure([&](){ unsubscribe(); }, locks.get()...);
+                        closure([&](){ unsubscribe(); }, reactive::details::unwrap(locks.get())...);
                     }, observable_locks);
                 }
             public:
@@ -155,42 +329,61 @@ namespace reactive{
                         return;
                     }
 
-                    auto observable_locks = reactive::details::MultiObserver::apply([](auto &... observables) {
-                        return std::make_tuple(observables->lock()...);
+                    OrderedSharedLock<sizeof...(ObservablePtrs)> ordered_lock;
+                    auto observable_locks = reactive::details::MultiObserver::apply([&](auto &... observables) {
+                        (void)std::initializer_list<int>{ (ordered_lock.add(*observables), 0)... };
+                        ordered_lock.lock();
+
+                        return std::make_tuple(observables->read_locked()...);
                     }, shared_ptrs);
 
                     apply_closure(std::forward<ClosureT>(closure), observable_locks, std::integral_constant<bool, add_unsubscibe_self>{});
                 }
             };
 
-            template<bool add_unsubscibe_self, class Closure, class ...Observables>
-            class ObserverNonBlocking : public ObserverBase<Closure, Observables...> {
-                using Base = ObserverBase<Closure, Observables...>;
-
-                using Base::lock;
-                using Lock = typename Base::Lock;
+            // Values cache - slot per observable, see ValueSlots.
+            // One lock over all values, closure gets consistent copy.
+            // atomic_slots (observe<nonblocking_atomic>), small trivially copyable values - lock-free atomic slots,
+            // writers of different observables do not contend; closure gets latest value of each observable,
+            // but not necessary all as of one moment.
+            template<bool add_unsubscibe_self, bool atomic_slots, class Closure, class ...ObservablePtrs>
+            class ObserverNonBlocking : public ObserverBase<Closure, ObservablePtrs...> {
+                using Base = ObserverBase<Closure, ObservablePtrs...>;
             public:
                 using Base::unsubscribe;
                 std::decay_t<Closure> closure;
 
-                std::tuple<typename Observables::Value...> observable_values;
+                // some observable may trigger from other thread
+                static constexpr const bool threadsafe = or_all(element_t<ObservablePtrs>::threadsafe...);
+
+                // values as they come from events (Snapshot<T> for snapshot properties)
+                threading::ValueSlots<threadsafe, atomic_slots, typename element_t<ObservablePtrs>::EventValue...> observable_values;
 
                 template<class ClosureT>
-                ObserverNonBlocking(ClosureT &&closure, const std::shared_ptr<Observables>&... observables)
+                ObserverNonBlocking(ClosureT &&closure, const ObservablePtrs&... observables)
                         : Base(observables...)
                         , closure(std::forward<ClosureT>(closure))
-                        , observable_values(observables->getCopy()...) {}
+                        , observable_values(observables->event_value()...) {}
 
             private:
+                decltype(auto) load_values() const {
+                    return observable_values.load();
+                }
+
                 template<class ClosureT, class TmpValues>
                 void apply_closure(ClosureT&& closure, const TmpValues& tmp_observable_values, std::false_type){
-                    reactive::details::MultiObserver::apply(std::forward<ClosureT>(closure), tmp_observable_values);
+                    reactive::details::MultiObserver::apply(
+                        [&](const auto&...args){
+                            closure( reactive::details::unwrap(args)... );
+                        }
+                        , tmp_observable_values
+                    );
                 }
                 template<class ClosureT, class TmpValues>
                 void apply_closure(ClosureT&& closure, const TmpValues& tmp_observable_values, std::true_type){
                     reactive::details::MultiObserver::apply(
-                        [&](auto&&...args){
-                            closure( [&](){ this->unsubscribe(); },  std::forward<decltype(args)>(args)... );
+                        [&](const auto&...args){
+                            closure( [&](){ this->unsubscribe(); },  reactive::details::unwrap(args)... );
                         }
                         , tmp_observable_values
                     );
@@ -201,24 +394,24 @@ namespace reactive{
                 template<class IntegralConstant, class Arg>
                 void run(IntegralConstant, Arg &&arg) {
                     // update values cache
-                    lock.lock();
-                        auto &value = std::get<IntegralConstant::value>(observable_values);
-                        value = std::forward<Arg>(arg);
-						const auto tmp_observable_values = observable_values;
-                    lock.unlock();
+                    const auto tmp_observable_values = observable_values.template store_load<IntegralConstant::value>(std::forward<Arg>(arg));
 
                     apply_closure(closure, tmp_observable_values, std::integral_constant<bool, add_unsubscibe_self>{});
                 }
 
+                // remember arg, for deferred execute()
+                template<class IntegralConstant, class Arg>
+                void cache(IntegralConstant, Arg &&arg) {
+                    observable_values.template store<IntegralConstant::value>(std::forward<Arg>(arg));
+                }
+
                 void execute() {
                     execute(closure);
                 }
 
                 template<class ClosureT>
                 void execute(ClosureT&& closure){
-                    lock.lock();
-                        const auto tmp_observable_values = observable_values;
-                    lock.unlock();
+                    const auto tmp_observable_values = load_values();
 
                     apply_closure(std::forward<ClosureT>(closure), tmp_observable_values, std::integral_constant<bool, add_unsubscibe_self>{});
                 }
@@ -226,23 +419,23 @@ namespace reactive{
             };
 
 
-            template<class blocking_mode = reactive::default_blocking, bool add_unsubscibe_self = false, class Closure, class ...Observables>
-            auto observe_impl(Closure &&closure, const std::shared_ptr<Observables>&... observables) {
+            template<class blocking_mode = reactive::default_blocking, bool add_unsubscibe_self = false, class Closure, class ...ObservablePtrs>
+            auto observe_impl(Closure &&closure, const ObservablePtrs&... observables) {
                 assert(and_all(observables...) && "all observables must exists on observe()!");
 
 				// mix_threadsafe only safe to work in nonblocking mode
-				constexpr const bool all_non_threadsafe	 = and_all(!Observables::threadsafe...);
-				constexpr const bool some_non_threadsafe = or_all (!Observables::threadsafe...);
+				constexpr const bool all_non_threadsafe	 = and_all(!element_t<ObservablePtrs>::threadsafe...);
+				constexpr const bool some_non_threadsafe = or_all (!element_t<ObservablePtrs>::threadsafe...);
 				constexpr const bool mix_threadsafe = some_non_threadsafe && !all_non_threadsafe;
 
-				constexpr const bool efficiently_copyable = reactive::details::default_blocking::is_efficiently_copyable<typename Observables::Value...>::value;
+				constexpr const bool efficiently_copyable = reactive::details::default_blocking::is_efficiently_copyable<typename element_t<ObservablePtrs>::Value...>::value;
 
 				static_assert(!(mix_threadsafe && std::is_same<blocking_mode, reactive::blocking>::value)
 					, "You trying to mix thread-safe with non-thread-safe properties in observer in blocking mode. Use default_blocking or nonblocking observer mode.");
 
 
 				// If someone in blocking mode - play safe, work in blocking mode too
-				constexpr const bool have_property_in_blocking_mode = or_all( std::is_same<typename Observables::blocking_mode, reactive::blocking>::value... );
+				constexpr const bool have_property_in_blocking_mode = or_all( std::is_same<typename element_t<ObservablePtrs>::blocking_mode, reactive::blocking>::value... );
 
 
 				constexpr const bool is_default_blocking = std::is_same<blocking_mode, reactive::default_blocking>::value;
@@ -257,17 +450,24 @@ namespace reactive{
 
                 using Observer = std::conditional_t<
                         do_blocking
-                        , ObserverBlocking<add_unsubscibe_self, Closure, Observables...>
-                        , ObserverNonBlocking<add_unsubscibe_self, Closure, Observables...>
+                        , ObserverBlocking<add_unsubscibe_self, Closure, ObservablePtrs...>
+                        , ObserverNonBlocking<add_unsubscibe_self, std::is_same<blocking_mode, reactive::nonblocking_atomic>::value, Closure, ObservablePtrs...>
                 >;
 
-                std::shared_ptr<Observer> observer = std::make_shared<Observer>(
+                using ObserverPointer = pointer_for<!all_non_threadsafe>;
+                auto observer = ObserverPointer::template make_shared<Observer>(
                         std::forward<Closure>(closure), observables...
                 );
 
                 foreach([&](auto i, auto &observable) {
                     using I = decltype(i);
                     observable->subscribe(observer->tag, [observer](auto &&arg) {
+                        if (reactive::details::TransactionState* transaction = reactive::details::TransactionState::current()) {
+                            // once per transaction wave, with latest values
+                            observer->cache(I{}, std::forward<decltype(arg)>(arg));
+                            transaction->defer_observer(observer);
+                            return;
+                        }
                         observer->run(I{}, std::forward<decltype(arg)>(arg));
                     });
                 }, observables...);
@@ -276,8 +476,8 @@ namespace reactive{
             }
 
 
-            template<class blocking_mode = reactive::default_blocking, class Closure, class ...Observables>
-            auto observe_w_unsubscribe_impl(Closure &&closure, const std::shared_ptr<Observables>&... observables) {
+            template<class blocking_mode = reactive::default_blocking, class Closure, class ...ObservablePtrs>
+            auto observe_w_unsubscribe_impl(Closure &&closure, const ObservablePtrs&... observables) {
                 return observe_impl<blocking_mode, true>(std::forward<Closure>(closure), observables...);
             };
 
@@ -287,7 +487,7 @@ namespace reactive{
 
 
     template<class blocking_mode = default_blocking, class Closure, class ...Observables>
-    auto observe(Closure&& closure, Observables&... observables){
+    Subscription observe(Closure&& closure, const Observables&... observables){
         return [
             observer = details::MultiObserver::observe_impl<blocking_mode>( std::forward<Closure>(closure), observables.shared_ptr()... )
         ](){
@@ -297,7 +497,7 @@ namespace reactive{
 
 
     template<class blocking_mode = default_blocking, class Closure, class ...Observables>
-    auto observe_w_unsubscribe(Closure&& closure, Observables&... observables){
+    Subscription observe_w_unsubscribe(Closure&& closure, const Observables&... observables){
         return
         [
             observer = details::MultiObserver::observe_impl<blocking_mode, true>( std::forward<Closure>(closure), observables.shared_ptr()... )
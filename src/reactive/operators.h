@@ -0,0 +1,663 @@
+#ifndef REACTIVE_OPERATORS_H
+#define REACTIVE_OPERATORS_H
+
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "details/Event.h"
+#include "details/utils/optional.hpp"
+#include "details/threading/SpinLock.h"
+#include "details/threading/dummy_mutex.h"
+#include "observer.h"
+#include "expression.h"
+#include "Scheduler.h"
+#include "Subscription.h"
+
+namespace reactive{
+
+	class PipelineBase {};
+
+	namespace details{
+	namespace operators{
+		template<class T>
+		using is_pipeline = std::is_base_of<PipelineBase, std::decay_t<T>>;
+
+
+		// Sources. subscribe(closure) return { Subscription, primer }.
+		// primer() pushes current value (if source have one) through closure.
+
+		template<class SharedPtr>
+		class PropertySource {
+			using Observable = typename SharedPtr::element_type;
+			SharedPtr ptr;
+		public:
+			using Value = typename Observable::Value;
+			static constexpr const bool threadsafe = Observable::threadsafe;
+
+			PropertySource(const SharedPtr& ptr)
+				: ptr(ptr) {}
+
+			unsigned rank() const {
+				return reactive::details::scheduler::rank_of(ptr, 0);
+			}
+
+			template<class Closure>
+			auto subscribe(Closure&& closure) const {
+				auto observer = reactive::details::MultiObserver::observe_impl(std::forward<Closure>(closure), ptr);
+				return std::make_pair(
+					Subscription([observer](){ observer->unsubscribe(); })
+					, [observer](){ observer->execute(); }
+				);
+			}
+		};
+
+		// Event not owned - it must outlive pipeline and all its subscriptions
+		// (Subscription call unsubscribes from event).
+		template<class ActionListLock, class ListMutationLock, class Arg>
+		class EventSource {
+			using Event = ConfigurableEventBase<ActionListLock, ListMutationLock, Arg>;
+			Event* event;
+		public:
+			using Value = std::decay_t<Arg>;
+			static constexpr const bool threadsafe = !std::is_same<ActionListLock, threading::dummy_mutex>::value;
+
+			EventSource(Event& event)
+				: event(&event) {}
+
+			unsigned rank() const {
+				return 0;
+			}
+
+			template<class Closure>
+			auto subscribe(Closure&& closure) const {
+				DelegateTag tag;
+				event->subscribe(tag, std::forward<Closure>(closure));
+				return std::make_pair(
+					Subscription([event = event, tag](){ (*event) -= tag; })
+					, [](){}
+				);
+			}
+		};
+
+		template<class T, class = std::enable_if_t< reactive::details::expression::is_property<T>::value >>
+		auto make_source(const T& property) {
+			return PropertySource<std::decay_t<decltype(property.shared_ptr())>>{ property.shared_ptr() };
+		}
+		template<class ActionListLock, class ListMutationLock, class Arg>
+		auto make_source(ConfigurableEventBase<ActionListLock, ListMutationLock, Arg>& event) {
+			return EventSource<ActionListLock, ListMutationLock, Arg>{ event };
+		}
+
+		template<class T>
+		using source_t = decltype(make_source(std::declval<T&>()));
+
+
+		// Chain state: all stage sinks, nested, in one object.
+		// Without lock - terminal sink calls closure directly.
+		template<class Sink>
+		struct Chain {
+			Sink sink;
+
+			Chain(Sink&& sink)
+				: sink(std::move(sink)) {}
+
+			template<class F>
+			void run(F&& f) {
+				f();
+			}
+		};
+
+		// terminal sink of LockedChain
+		template<class Value>
+		struct QueueSink {
+			std::vector<Value>* queue;
+
+			template<class Arg>
+			void operator()(const Arg& arg) {
+				queue->emplace_back(arg);
+			}
+			template<class Attach>
+			void attach(Attach&) {}
+		};
+
+		// One lock per chain - only if some stage have state, or there are several sources.
+		// Sinks output queued, and passed to closure after sinks return.
+		// Closure may write to chain's source: re-entry detected by lock owner -
+		// sinks run right away (they are idle), output passed after closure returns.
+		template<class Value, class Closure, class Sink>
+		struct LockedChain {
+			threading::SpinLock<threading::SpinLockMode::Adaptive> lock;
+			std::atomic<std::thread::id> owner{ std::thread::id{} };
+			std::vector<Value> queue;
+			std::vector<Value> emitting;
+			Closure closure;
+			Sink sink;
+
+			template<class MakeSink>
+			LockedChain(Closure&& closure, MakeSink&& make_sink)
+				: closure(std::move(closure))
+				, sink(make_sink(QueueSink<Value>{ &queue })) {}
+
+			// f() pushes value through sink
+			template<class F>
+			void run(F&& f) {
+				const std::thread::id self = std::this_thread::get_id();
+				if (owner.load(std::memory_order_relaxed) == self) {
+					f();
+					return;
+				}
+
+				std::unique_lock<decltype(lock)> l(lock);
+				owner.store(self, std::memory_order_relaxed);
+				try {
+					f();
+					while (!queue.empty()) {
+						emitting.swap(queue);
+						for (const Value& value : emitting) closure(value);
+						emitting.clear();
+					}
+				} catch (...) {
+					queue.clear();
+					emitting.clear();
+					owner.store({}, std::memory_order_relaxed);
+					throw;
+				}
+				owner.store({}, std::memory_order_relaxed);
+			}
+		};
+
+		// Subscribes additional sources of stages (sample, combine_latest, ...).
+		// Sinks release their sources after attach - chain must not hold observables (shared_ptr cycle).
+		template<class ChainPtr>
+		struct Attacher {
+			const ChainPtr& chain;
+			std::vector<Subscription>& subscriptions;
+			std::vector<std::function<void()>>& primers;
+
+			// closure(values...) called under chain lock
+			template<class Source, class Closure>
+			void operator()(const Source& source, Closure&& closure) {
+				auto subscribed = source.subscribe([chain = chain, closure = std::forward<Closure>(closure)](const auto& value){
+					chain->run([&]() { closure(value); });
+				});
+				subscriptions.emplace_back(std::move(subscribed.first));
+				primers.emplace_back(std::move(subscribed.second));
+			}
+		};
+
+		// terminal sink
+		template<class Closure>
+		struct ClosureSink {
+			Closure closure;
+
+			template<class Arg>
+			void operator()(const Arg& arg) {
+				closure(arg);
+			}
+			template<class Attach>
+			void attach(Attach&) {}
+		};
+
+
+		struct Stage {
+			static constexpr const bool stateful = false;
+			static constexpr const bool have_sources = false;
+
+			unsigned rank() const {
+				return 0;
+			}
+		};
+
+
+		template<class F>
+		struct Map : Stage {
+			F f;
+
+			template<class In>
+			using Out = std::decay_t<decltype(std::declval<const F&>()(std::declval<const In&>()))>;
+
+			template<class Next>
+			struct Sink {
+				F f;
+				Next next;
+
+				template<class Arg>
+				void operator()(const Arg& arg) {
+					next(f(arg));
+				}
+				template<class Attach>
+				void attach(Attach& attach) {
+					next.attach(attach);
+				}
+			};
+
+			template<class In, class Next>
+			Sink<std::decay_t<Next>> sink(Next&& next) const {
+				return { f, std::forward<Next>(next) };
+			}
+		};
+
+		template<class F>
+		struct Filter : Stage {
+			F f;
+
+			template<class In>
+			using Out = In;
+
+			template<class Next>
+			struct Sink {
+				F f;
+				Next next;
+
+				template<class Arg>
+				void operator()(const Arg& arg) {
+					if (f(arg)) next(arg);
+				}
+				template<class Attach>
+				void attach(Attach& attach) {
+					next.attach(attach);
+				}
+			};
+
+			template<class In, class Next>
+			Sink<std::decay_t<Next>> sink(Next&& next) const {
+				return { f, std::forward<Next>(next) };
+			}
+		};
+
+		template<class Acc, class F>
+		struct Scan : Stage {
+			static constexpr const bool stateful = true;
+			Acc seed;
+			F f;
+
+			template<class In>
+			using Out = Acc;
+
+			template<class Next>
+			struct Sink {
+				Acc acc;
+				F f;
+				Next next;
+
+				template<class Arg>
+				void operator()(const Arg& arg) {
+					acc = f(acc, arg);
+					next(acc);
+				}
+				template<class Attach>
+				void attach(Attach& attach) {
+					next.attach(attach);
+				}
+			};
+
+			template<class In, class Next>
+			Sink<std::decay_t<Next>> sink(Next&& next) const {
+				return { seed, f, std::forward<Next>(next) };
+			}
+		};
+
+		struct DistinctUntilChanged : Stage {
+			static constexpr const bool stateful = true;
+
+			template<class In>
+			using Out = In;
+
+			template<class In, class Next>
+			struct Sink {
+				nonstd::optional<In> last;
+				Next next;
+
+				void operator()(const In& arg) {
+					if (last && *last == arg) return;
+					last = arg;
+					next(arg);
+				}
+				template<class Attach>
+				void attach(Attach& attach) {
+					next.attach(attach);
+				}
+			};
+
+			template<class In, class Next>
+			Sink<In, std::decay_t<Next>> sink(Next&& next) const {
+				return { {}, std::forward<Next>(next) };
+			}
+		};
+
+		struct BufferCount : Stage {
+			static constexpr const bool stateful = true;
+			std::size_t count;
+
+			template<class In>
+			using Out = std::vector<In>;
+
+			template<class In, class Next>
+			struct Sink {
+				std::size_t count;
+				std::vector<In> buffer;
+				Next next;
+
+				void operator()(const In& arg) {
+					buffer.emplace_back(arg);
+					if (buffer.size() < count) return;
+
+					next(buffer);
+					buffer.clear();
+				}
+				template<class Attach>
+				void attach(Attach& attach) {
+					next.attach(attach);
+				}
+			};
+
+			template<class In, class Next>
+			Sink<In, std::decay_t<Next>> sink(Next&& next) const {
+				Sink<In, std::decay_t<Next>> sink{ count, {}, std::forward<Next>(next) };
+				sink.buffer.reserve(count);
+				return sink;
+			}
+		};
+
+		// emit latest value, when notifier fires (if there was new value since last emit)
+		template<class Notifier>
+		struct Sample : Stage {
+			static constexpr const bool stateful = true;
+			static constexpr const bool have_sources = true;
+			Notifier notifier;
+
+			unsigned rank() const {
+				return notifier.rank();
+			}
+
+			template<class In>
+			using Out = In;
+
+			template<class In, class Next>
+			struct Sink {
+				nonstd::optional<Notifier> notifier;
+				nonstd::optional<In> latest;
+				bool fresh = false;
+				Next next;
+
+				void operator()(const In& arg) {
+					latest = arg;
+					fresh = true;
+				}
+				template<class Attach>
+				void attach(Attach& attach) {
+					attach(*notifier, [this](const auto&){
+						if (!fresh) return;
+						fresh = false;
+						next(*latest);
+					});
+					notifier.reset();
+					next.attach(attach);
+				}
+			};
+
+			template<class In, class Next>
+			Sink<In, std::decay_t<Next>> sink(Next&& next) const {
+				return { notifier, {}, false, std::forward<Next>(next) };
+			}
+		};
+
+
+		// f(upstream, others...), once all have value.
+		// emit_on_others == false - emit only on upstream (with_latest_from).
+		template<bool emit_on_others, class F, class ...Sources>
+		struct Latest : Stage {
+			static constexpr const bool stateful = true;
+			static constexpr const bool have_sources = true;
+			F f;
+			std::tuple<Sources...> sources;
+
+			unsigned rank() const {
+				unsigned result = 0;
+				reactive::details::expression::apply([&](const auto&... sources){
+					(void)std::initializer_list<int>{ (result = std::max(result, sources.rank()), 0)... };
+				}, sources);
+				return result;
+			}
+
+			template<class In>
+			using Out = std::decay_t<decltype(std::declval<const F&>()(std::declval<const In&>(), std::declval<const typename Sources::Value&>()...))>;
+
+			template<class In, class Next>
+			struct Sink {
+				F f;
+				nonstd::optional<std::tuple<Sources...>> sources;
+				nonstd::optional<In> latest;
+				std::tuple<nonstd::optional<typename Sources::Value>...> others;
+				Next next;
+
+				template<std::size_t ...Is>
+				void emit(std::index_sequence<Is...>) {
+					if (!latest || !reactive::details::MultiObserver::and_all(bool(std::get<Is>(others))...)) return;
+					next(f(*latest, *std::get<Is>(others)...));
+				}
+				void emit() {
+					emit(std::index_sequence_for<Sources...>{});
+				}
+
+				void operator()(const In& arg) {
+					latest = arg;
+					emit();
+				}
+
+				template<class Attach, std::size_t ...Is>
+				void attach_sources(Attach& attach, std::index_sequence<Is...>) {
+					(void)std::initializer_list<int>{ (attach(std::get<Is>(*sources), [this](const auto& value){
+						std::get<Is>(others) = value;
+						if (emit_on_others) emit();
+					}), 0)... };
+				}
+				template<class Attach>
+				void attach(Attach& attach) {
+					attach_sources(attach, std::index_sequence_for<Sources...>{});
+					sources.reset();
+					next.attach(attach);
+				}
+			};
+
+			template<class In, class Next>
+			Sink<In, std::decay_t<Next>> sink(Next&& next) const {
+				return { f, sources, {}, {}, std::forward<Next>(next) };
+			}
+		};
+
+
+		// Out type after stages
+		template<class In, class ...Stages>
+		struct out;
+		template<class In>
+		struct out<In> {
+			using type = In;
+		};
+		template<class In, class Stage, class ...Stages>
+		struct out<In, Stage, Stages...> {
+			using type = typename out<typename Stage::template Out<In>, Stages...>::type;
+		};
+	}
+	}
+
+
+	// Source | operator | operator ... - compiles into one observer closure:
+	// stage sinks nested by value, in one allocation, with one lock (if needed).
+	// Nothing evaluated until subscribe() / ReactiveProperty::set(pipeline).
+	template<class Source, class ...Stages>
+	class Pipeline : PipelineBase {
+		template<class, class ...> friend class Pipeline;
+
+		Source source;
+		std::tuple<Stages...> stages;
+
+		template<std::size_t I, class In, class Next>
+		auto make_sink(Next&& next, std::false_type is_end) const {
+			using Stage = std::tuple_element_t<I, std::tuple<Stages...>>;
+			return std::get<I>(stages).template sink<In>(
+				make_sink<I + 1, typename Stage::template Out<In>>(std::forward<Next>(next)
+					, std::integral_constant<bool, I + 1 == sizeof...(Stages)>{})
+			);
+		}
+		template<std::size_t I, class In, class Next>
+		std::decay_t<Next> make_sink(Next&& next, std::true_type is_end) const {
+			return std::forward<Next>(next);
+		}
+
+		static constexpr const bool need_lock =
+			details::MultiObserver::or_all(Stages::stateful..., Stages::have_sources...)
+			&& (Source::threadsafe || details::MultiObserver::or_all(Stages::have_sources...));
+	public:
+		using Value = typename details::operators::out<typename Source::Value, Stages...>::type;
+	private:
+		template<class Terminal>
+		auto make_sinks(Terminal&& terminal) const {
+			return make_sink<0, typename Source::Value>(std::forward<Terminal>(terminal)
+				, std::integral_constant<bool, sizeof...(Stages) == 0>{});
+		}
+
+		template<class Closure>
+		auto make_chain(Closure&& closure, std::false_type need_lock) const {
+			using namespace details::operators;
+			auto sink = make_sinks(ClosureSink<std::decay_t<Closure>>{ std::forward<Closure>(closure) });
+			return std::make_shared<Chain<decltype(sink)>>(std::move(sink));
+		}
+		template<class Closure>
+		auto make_chain(Closure&& closure, std::true_type need_lock) const {
+			using namespace details::operators;
+			using Sink = decltype(make_sinks(std::declval<QueueSink<Value>>()));
+			return std::make_shared<LockedChain<Value, std::decay_t<Closure>, Sink>>(
+				std::forward<Closure>(closure)
+				, [&](QueueSink<Value>&& terminal){ return make_sinks(std::move(terminal)); }
+			);
+		}
+	public:
+
+		Pipeline(const Source& source, const std::tuple<Stages...>& stages)
+			: source(source)
+			, stages(stages) {}
+
+		template<class Stage>
+		Pipeline<Source, Stages..., std::decay_t<Stage>> operator|(Stage&& stage) const {
+			return { source, std::tuple_cat(stages, std::make_tuple(std::forward<Stage>(stage))) };
+		}
+
+		// see Scheduler
+		unsigned rank() const {
+			unsigned result = source.rank();
+			details::expression::apply([&](const auto&... stages){
+				(void)std::initializer_list<int>{ (result = std::max(result, stages.rank()), 0)... };
+			}, stages);
+			return result + 1;
+		}
+
+		// Subscribe without pushing current values. Return { Subscription, primer() }.
+		template<class Closure>
+		auto subscribe_unprimed(Closure&& closure) const {
+			using namespace details::operators;
+
+			auto chain = make_chain(std::forward<Closure>(closure), std::integral_constant<bool, need_lock>{});
+
+			std::vector<Subscription> subscriptions;
+			std::vector<std::function<void()>> primers;
+			Attacher<decltype(chain)> attacher{ chain, subscriptions, primers };
+			chain->sink.attach(attacher);
+
+			auto subscribed = source.subscribe([chain](const auto& value){
+				chain->run([&]() { chain->sink(value); });
+			});
+
+			// other sources primed first - to have values, when main source primed
+			primers.emplace_back(std::move(subscribed.second));
+			subscriptions.emplace_back(std::move(subscribed.first));
+
+			return std::make_pair(
+				Subscription([subscriptions = std::move(subscriptions)](){
+					for (const Subscription& subscription : subscriptions) subscription();
+				})
+				, [primers = std::move(primers)](){
+					for (const auto& primer : primers) primer();
+				}
+			);
+		}
+
+		// closure(const Value&). Property sources push their current values right away.
+		template<class Closure>
+		Subscription subscribe(Closure&& closure) const {
+			auto subscribed = subscribe_unprimed(std::forward<Closure>(closure));
+			subscribed.second();
+			return std::move(subscribed.first);
+		}
+	};
+
+
+	namespace operators{
+
+		// ObservableProperty / ReactiveProperty / Event<T>
+		// Event referenced, not owned - must outlive pipeline and its subscriptions.
+		template<class Source>
+		Pipeline<details::operators::source_t<Source>> from(Source& source) {
+			return { details::operators::make_source(source), {} };
+		}
+
+		// f(value) -> new value
+		template<class F>
+		details::operators::Map<std::decay_t<F>> map(F&& f) {
+			return { {}, std::forward<F>(f) };
+		}
+
+		// pass value if pred(value)
+		template<class F>
+		details::operators::Filter<std::decay_t<F>> filter(F&& pred) {
+			return { {}, std::forward<F>(pred) };
+		}
+
+		// acc = f(acc, value), emit acc
+		template<class Acc, class F>
+		details::operators::Scan<std::decay_t<Acc>, std::decay_t<F>> scan(Acc&& seed, F&& f) {
+			return { {}, std::forward<Acc>(seed), std::forward<F>(f) };
+		}
+
+		// skip value, equal to previous one
+		inline details::operators::DistinctUntilChanged distinct_until_changed() {
+			return {};
+		}
+
+		// emit latest value, when notifier changes (if there was new value since last emit)
+		template<class Notifier>
+		details::operators::Sample<details::operators::source_t<Notifier>> sample(Notifier& notifier) {
+			return { {}, details::operators::make_source(notifier) };
+		}
+
+		// emit std::vector of each count values
+		inline details::operators::BufferCount buffer_count(std::size_t count) {
+			return { {}, count };
+		}
+
+		// f(value, others...), on change of any (once all have value)
+		template<class F, class ...Others>
+		details::operators::Latest<true, std::decay_t<F>, details::operators::source_t<Others>...>
+		combine_latest(F&& f, Others&... others) {
+			return { {}, std::forward<F>(f), std::make_tuple(details::operators::make_source(others)...) };
+		}
+
+		// f(value, others...), on change of value only (once all have value)
+		template<class F, class ...Others>
+		details::operators::Latest<false, std::decay_t<F>, details::operators::source_t<Others>...>
+		with_latest_from(F&& f, Others&... others) {
+			return { {}, std::forward<F>(f), std::make_tuple(details::operators::make_source(others)...) };
+		}
+	}
+
+}
+
+#endif //REACTIVE_OPERATORS_H
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+
+#include <reactive/ObservableProperty.h>
+
+class BenchmarkChangeDetection {
+public:
+	const int count = 100'000;
+
+	// Sample buffer, set with same value, except last element - full comparison each set.
+	template<class change_detection, std::size_t size>
+	void benchmark_set() {
+		using T = std::array<float, size>;
+
+		using namespace std::chrono;
+
+		reactive::ObservableProperty<T, reactive::blocking, true, change_detection> source{ T{} };
+		long long events = 0;
+		source += [&](const T&) { events++; };
+
+		high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+		T value{};
+		for (int i = 0; i < count; i++) {
+			value.back() = float(i / 2);
+			source = value;
+		}
+
+		high_resolution_clock::time_point t2 = high_resolution_clock::now();
+		auto duration = duration_cast<milliseconds>(t2 - t1).count();
+		std::cout << "updated in : " << duration
+				  << " (" << events << ")"
+				  << std::endl;
+	}
+
+	template<std::size_t size>
+	void benchmark_size() {
+		std::cout << "Test equal, " << size * sizeof(float) << " bytes." << std::endl;
+		benchmark_set<reactive::change_detection::equal, size>();
+		std::cout << "---" << std::endl;
+
+		std::cout << "Test bitwise, " << size * sizeof(float) << " bytes." << std::endl;
+		benchmark_set<reactive::change_detection::bitwise, size>();
+		std::cout << "---" << std::endl;
+
+		std::cout << "Test bitwise_range, " << size * sizeof(float) << " bytes." << std::endl;
+		benchmark_set<reactive::change_detection::bitwise_range, size>();
+		std::cout << "---" << std::endl;
+	}
+
+	void benchmark_all() {
+		benchmark_size<64>();
+		benchmark_size<4096>();
+	}
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#include <reactive/ObservableProperty.h>
+#include <reactive/observer.h>
+
+// 4-input observer, each input written by own thread.
+class BenchmarkMultiWriter {
+public:
+	const int count = 200'000;
+
+	// 24 bytes, trivially copyable - locked slots
+	struct Vec3 {
+		long long x, y, z;
+		bool operator==(const Vec3& other) const {
+			return x == other.x && y == other.y && z == other.z;
+		}
+	};
+
+	template<class T, class Mode, class MakeValue, class Check>
+	void benchmark_writers(int writers_count, MakeValue&& make_value, Check&& check) {
+		using namespace std::chrono;
+		using Property = reactive::ObservableProperty<T, reactive::nonblocking>;
+
+		Property x1, x2, x3, x4;
+		std::atomic<long long> torn{0};
+
+		auto unsubscribe = reactive::observe<Mode>([&](const T& x1, const T& x2, const T& x3, const T& x4) {
+			if (!check(x1) || !check(x2) || !check(x3) || !check(x4)) {
+				torn.fetch_add(1, std::memory_order_relaxed);
+			}
+		}, x1, x2, x3, x4);
+
+		Property* inputs[] = { &x1, &x2, &x3, &x4 };
+
+		high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+		std::vector<std::thread> threads;
+		for (int w = 0; w < writers_count; ++w) {
+			threads.emplace_back([&, w]() {
+				Property& input = *inputs[w];
+				for (int i = 0; i < count; i++) {
+					input = make_value(i);
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		high_resolution_clock::time_point t2 = high_resolution_clock::now();
+		auto duration = duration_cast<milliseconds>(t2 - t1).count();
+		std::cout << writers_count << " writers : " << duration
+				  << " (torn " << torn.load() << ")"
+				  << std::endl;
+		unsubscribe();
+	}
+
+	void benchmark_all() {
+		std::cout << "Test long long (locked slots)." << std::endl;
+		for (int writers = 1; writers <= 4; writers *= 2) {
+			benchmark_writers<long long, reactive::nonblocking>(writers, [](int i) { return (long long)i; }, [](long long) { return true; });
+		}
+		std::cout << "---" << std::endl;
+
+		std::cout << "Test long long (atomic slots, observe<nonblocking_atomic>)." << std::endl;
+		for (int writers = 1; writers <= 4; writers *= 2) {
+			benchmark_writers<long long, reactive::nonblocking_atomic>(writers, [](int i) { return (long long)i; }, [](long long) { return true; });
+		}
+		std::cout << "---" << std::endl;
+
+		std::cout << "Test Vec3 (locked slots)." << std::endl;
+		for (int writers = 1; writers <= 4; writers *= 2) {
+			benchmark_writers<Vec3, reactive::nonblocking>(writers
+				, [](int i) { return Vec3{ i, i, i }; }
+				, [](const Vec3& v) { return v.x == v.y && v.y == v.z; });
+		}
+		std::cout << "---" << std::endl;
+	}
+};
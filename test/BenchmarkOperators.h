@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+
+#include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
+#include <reactive/operators.h>
+
+class BenchmarkOperators {
+public:
+	const int count = 1'000'000;
+
+	template<class Fill>
+	void benchmark_update(Fill&& fill) {
+		using namespace std::chrono;
+
+		reactive::ObservableProperty<long long> source = 0;
+		reactive::ReactiveProperty<long long> result;
+		[[maybe_unused]] auto holder = fill(source, result);
+
+		high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+		for (int i = 0; i < count; i++) {
+			source = i;
+		}
+
+		high_resolution_clock::time_point t2 = high_resolution_clock::now();
+		auto duration = duration_cast<milliseconds>(t2 - t1).count();
+		std::cout << "updated in : " << duration
+				  << " (" << result.getCopy() << ")"
+				  << std::endl;
+	}
+
+	void benchmark_all() {
+		// x -> x*2 -> odd? -> x+1 -> distinct
+		{
+			std::cout << "Test intermediate properties."  << std::endl;
+			benchmark_update([](auto& source, auto& result) {
+				using Property = reactive::ReactiveProperty<long long>;
+				std::vector<Property> stages(2);
+				stages[0].set([](long long x){ return x * 2; }, source);
+				stages[1].set([](long long x){ return x + 1; }, stages[0]);
+				result.set([](long long x){ return x; }, stages[1]);
+				return stages;
+			});
+			std::cout << "---"  << std::endl;
+		}
+		{
+			std::cout << "Test operators."  << std::endl;
+			benchmark_update([](auto& source, auto& result) {
+				using namespace reactive::operators;
+				result = from(source)
+					| map([](long long x){ return x * 2; })
+					| map([](long long x){ return x + 1; })
+					| distinct_until_changed();
+				return 0;
+			});
+			std::cout << "---"  << std::endl;
+		}
+
+		char ch;
+		std::cin >> ch;
+	}
+};
@@ -5,6 +5,7 @@
 #include <memory>
 
 #include <reactive/ObservableProperty.h>
+#include <reactive/ObservablePropertyArray.h>
 
 class BenchmarkOwnedProperty {
 public:
@@ -189,7 +190,54 @@ public:
 	}
 
 
+	// SoA: x1..x4 - arrays of properties
+	void benchmark_array() {
+		using namespace std::chrono;
+
+		std::vector< reactive::ObservablePropertyArray<int> > list;
+		{
+			high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+			for (int x = 0; x < 4; ++x) {
+				list.emplace_back(count);
+			}
+			for (int i = 0; i < count; ++i) {
+				for (int x = 0; x < 4; ++x) {
+					list[x].set(i, i + x);
+				}
+			}
+
+			high_resolution_clock::time_point t2 = high_resolution_clock::now();
+			auto duration = duration_cast<microseconds>(t2 - t1).count();
+			std::cout << "Added in : " << duration << std::endl;
+		}
+		{
+			high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+			int sum = 0;
+			for (int i = 0; i < count; ++i) {
+				sum += list[0].get(i) + list[1].get(i) + list[2].get(i) + list[3].get(i);
+			}
+
+			high_resolution_clock::time_point t2 = high_resolution_clock::now();
+			auto duration = duration_cast<microseconds>(t2 - t1).count();
+			std::cout << "Traverse in : " << duration << std::endl;
+			std::cout << sum << std::endl;
+		}
+	}
+
+
+	void report_sizes() {
+		std::cout << "sizeof details::ObservableProperty<int> nonblocking_atomic : " << sizeof(reactive::details::ObservableProperty<int, reactive::nonblocking_atomic>) << std::endl;
+		std::cout << "sizeof details::ObservableProperty<int> nonblocking : " << sizeof(reactive::details::ObservableProperty<int, reactive::nonblocking>) << std::endl;
+		std::cout << "sizeof details::ObservableProperty<int> blocking : " << sizeof(reactive::details::ObservableProperty<int, reactive::blocking>) << std::endl;
+		std::cout << "sizeof Data : " << sizeof(Data) << ", Data_plain : " << sizeof(Data_plain) << std::endl;
+		std::cout << std::endl;
+	}
+
 	void benchmark_all() {
+		report_sizes();
+
 		std::cout << "Plain" << std::endl;
 		benchmark_plain();
 		std::cout << std::endl;
@@ -205,5 +253,9 @@ public:
 		std::cout << "no threaded Properties" << std::endl;
 		benchmark_properties<Data3>();
 		std::cout << std::endl;
+
+		std::cout << "Property arrays" << std::endl;
+		benchmark_array();
+		std::cout << std::endl;
 	}
 };
\ No newline at end of file
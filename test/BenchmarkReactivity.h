@@ -5,6 +5,7 @@
 
 #include <reactive/blocking.h>
 #include <reactive/ReactiveProperty.h>
+#include <reactive/Transaction.h>
 #include <reactive/non_thread_safe/ReactiveProperty.h>
 #include <reactive/non_thread_safe/ObservableProperty.h>
 
@@ -32,6 +33,35 @@ public:
 		}
 	};
 
+	// same as Data, but sum is expression - evaluated in one node
+	template<class T, class R>
+	struct DataExpression {
+		T x1, x2, x3, x4;
+		R sum;
+
+		DataExpression() {
+			sum.set(x1 + x2 + x3 + x4);
+		}
+
+		template<class I1, class I2, class I3, class I4>
+		void update(I1&& x1, I2&& x2, I3&& x3, I4&& x4) {
+			this->x1 = x1;
+			this->x2 = x2;
+			this->x3 = x3;
+			this->x4 = x4;
+		}
+	};
+
+	// same as Data, but sum recomputed once per update
+	template<class T, class R>
+	struct DataTransaction : Data<T, R> {
+		template<class I1, class I2, class I3, class I4>
+		void update(I1&& x1, I2&& x2, I3&& x3, I4&& x4) {
+			reactive::Transaction transaction;
+			Data<T, R>::update(x1, x2, x3, x4);
+		}
+	};
+
 	template<class Container>
 	void benchmark_fill(Container& container) {
 		using namespace std::chrono;
@@ -75,6 +105,30 @@ public:
 			benchmark_update(list);
 			std::cout << "---"  << std::endl;
 		}
+		{
+			std::cout << "Test threaded expression."  << std::endl;
+			using Element = DataExpression<reactive::ObservableProperty<T>, reactive::ReactiveProperty<T> >;
+			std::vector<Element> list;
+			benchmark_fill(list);
+			benchmark_update(list);
+			std::cout << "---"  << std::endl;
+		}
+		{
+			std::cout << "Test threaded transaction."  << std::endl;
+			using Element = DataTransaction<reactive::ObservableProperty<T>, reactive::ReactiveProperty<T> >;
+			std::vector<Element> list;
+			benchmark_fill(list);
+			benchmark_update(list);
+			std::cout << "---"  << std::endl;
+		}
+		{
+			std::cout << "Test threaded blocking."  << std::endl;
+			using Element = Data<reactive::ObservableProperty<T, reactive::blocking>, reactive::ReactiveProperty<T, reactive::blocking> >;
+			std::vector<Element> list;
+			benchmark_fill(list);
+			benchmark_update(list);
+			std::cout << "---"  << std::endl;
+		}
 		{
 			std::cout << "Test non-threaded."  << std::endl;
 			using Element = Data<reactive::non_thread_safe::ObservableProperty<T>, reactive::non_thread_safe::ReactiveProperty<T> >;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <cmath>
+
+#include <reactive/Scheduler.h>
+#include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
+
+class BenchmarkScheduler {
+public:
+	const int count = 10'000;
+	const int work  = 2'000;		// closure cost
+	const int updates = 10;
+
+	template<class Flush>
+	void benchmark_flush(Flush&& flush) {
+		using namespace std::chrono;
+
+		reactive::Scheduler scheduler;
+		reactive::ObservableProperty<double> x = 1.0;
+
+		std::vector<reactive::ReactiveProperty<double>> nodes(count);
+		for (auto& node : nodes) {
+			node.set_deferred(scheduler, [work = work](double x) {
+				double result = x;
+				for (int i = 0; i < work; ++i) {
+					result = std::sqrt(result + i);
+				}
+				return result;
+			}, x);
+		}
+
+		high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+		for (int i = 0; i < updates; ++i) {
+			x = double(i);
+			flush(scheduler);
+		}
+
+		high_resolution_clock::time_point t2 = high_resolution_clock::now();
+		auto duration = duration_cast<milliseconds>(t2 - t1).count();
+		std::cout << "flushed in : " << duration
+				  << " (" << nodes.back().getCopy() << ")"
+				  << std::endl;
+	}
+
+	void benchmark_all() {
+		{
+			std::cout << "Test sequential flush." << std::endl;
+			benchmark_flush([](reactive::Scheduler& scheduler) {
+				scheduler.flush();
+			});
+			std::cout << "---" << std::endl;
+		}
+		{
+			threading::WorkStealingPool pool;
+			std::cout << "Test parallel flush (" << pool.size() << " threads)." << std::endl;
+			benchmark_flush([&](reactive::Scheduler& scheduler) {
+				scheduler.flush(pool);
+			});
+			std::cout << "---" << std::endl;
+		}
+	}
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <chrono>
+
+#include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
+
+class BenchmarkSnapshot {
+public:
+	const int count = 100'000;
+	const int observers_count = 8;
+
+	template<class blocking_mode, std::size_t size>
+	void benchmark_update() {
+		using T = std::array<long long, size>;
+
+		using namespace std::chrono;
+
+		reactive::ObservableProperty<T, blocking_mode> source;
+		std::vector<reactive::ReactiveProperty<long long>> observers(observers_count);
+		for (int i = 0; i < observers_count; ++i) {
+			observers[i].set([i](const T& value) {
+				return value[i];
+			}, source);
+		}
+
+		high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+		T value{};
+		for (int i = 0; i < count; i++) {
+			value.fill(i);
+			source = value;
+		}
+
+		high_resolution_clock::time_point t2 = high_resolution_clock::now();
+		auto duration = duration_cast<milliseconds>(t2 - t1).count();
+		std::cout << "updated in : " << duration
+				  << " (" << observers.back().getCopy() << ")"
+				  << std::endl;
+	}
+
+	template<std::size_t size>
+	void benchmark_size() {
+		std::cout << "Test nonblocking, " << size * sizeof(long long) << " bytes." << std::endl;
+		benchmark_update<reactive::nonblocking, size>();
+		std::cout << "---" << std::endl;
+
+		std::cout << "Test snapshot, " << size * sizeof(long long) << " bytes." << std::endl;
+		benchmark_update<reactive::snapshot, size>();
+		std::cout << "---" << std::endl;
+	}
+
+	void benchmark_all() {
+		benchmark_size<16>();
+		benchmark_size<128>();
+	}
+};
@@ -0,0 +1,141 @@
+#ifndef TEST_TESTCOROUTINE_H
+#define TEST_TESTCOROUTINE_H
+
+#include <iostream>
+#include <string>
+
+#include <reactive/Event.h>
+#include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
+
+// require C++20 coroutines
+class TestCoroutine{
+#if defined(__cpp_impl_coroutine)
+    // fire and forget
+    struct Task {
+        struct promise_type {
+            Task get_return_object() { return {}; }
+            std::suspend_never initial_suspend() { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    // owns coroutine - destroyed with it
+    struct Handle {
+        struct promise_type {
+            Handle get_return_object() { return { std::coroutine_handle<promise_type>::from_promise(*this) }; }
+            std::suspend_never initial_suspend() { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+        std::coroutine_handle<promise_type> handle;
+
+        ~Handle() { handle.destroy(); }
+    };
+
+    static Handle owned_next(reactive::ObservableProperty<int>& x){
+        int value = co_await x.next();
+        std::cout << "owned next = " << value << std::endl;
+    }
+
+    static Handle owned_values(reactive::ObservableProperty<int>& x){
+        auto values = x.values();
+        while (true) {
+            int value = co_await values.next();
+            std::cout << "owned value = " << value << std::endl;
+        }
+    }
+
+    static Task wait_next(reactive::ObservableProperty<int>& x){
+        int value = co_await x.next();
+        std::cout << "next = " << value << std::endl;
+    }
+
+    static Task wait_until(reactive::ReactiveProperty<int>& x){
+        int value = co_await x.until([](int x){ return x > 10; });
+        std::cout << "until = " << value << std::endl;
+    }
+
+    static Task wait_event(reactive::Event<int, std::string>& event){
+        auto [i, s] = co_await event.next();
+        std::cout << "event = " << i << " " << s << std::endl;
+    }
+
+    static Task read_values(reactive::ObservableProperty<int>& x, int count){
+        auto values = x.values();
+        for (int i = 0; i < count; ++i) {
+            int value = co_await values.next();
+            std::cout << "value = " << value << std::endl;
+        }
+    }
+
+public:
+    void test_next(){
+        reactive::ObservableProperty<int> x = 1;
+        wait_next(x);
+        x = 2;          // next = 2
+        x = 3;
+    }
+
+    void test_until(){
+        reactive::ObservableProperty<int> x = 1;
+        reactive::ReactiveProperty<int> y;
+        y.set([](int x){ return x * 2; }, x);
+
+        wait_until(y);
+        x = 3;
+        x = 6;          // until = 12
+        x = 7;
+
+        wait_until(y);  // until = 14, without suspension
+    }
+
+    void test_event(){
+        reactive::Event<int, std::string> event;
+        wait_event(event);
+        event(1, std::string("one"));     // event = 1 one
+        event(2, std::string("two"));
+    }
+
+    void test_values(){
+        reactive::ObservableProperty<int> x = 0;
+        read_values(x, 3);
+        x = 1;          // value = 1
+        x = 2;          // value = 2
+        x = 3;          // value = 3
+        x = 4;
+    }
+
+    // destroyed while suspended - not resumed
+    void test_destroyed(){
+        reactive::ObservableProperty<int> x = 0;
+        {
+            Handle next = owned_next(x);
+        }
+        {
+            Handle values = owned_values(x);
+            x = 1;      // owned value = 1
+        }
+        x = 2;
+        std::cout << "destroyed" << std::endl;
+    }
+
+    void test_all(){
+        test_next();
+        test_until();
+        test_event();
+        test_values();
+        test_destroyed();
+    }
+#else
+public:
+    void test_all(){
+        std::cout << "coroutines not supported" << std::endl;
+    }
+#endif
+};
+
+#endif //TEST_TESTCOROUTINE_H
@@ -0,0 +1,116 @@
+#ifndef TEST_TESTDYNAMICOBSERVER_H
+#define TEST_TESTDYNAMICOBSERVER_H
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#include <reactive/dynamic_observer.h>
+#include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
+
+class TestDynamicObserver{
+public:
+    void test_observe_each(){
+        std::vector<reactive::ObservableProperty<int>> list;
+        for (int i = 0; i < 5; ++i) {
+            list.emplace_back(i);
+        }
+
+        auto unsubscribe = reactive::observe_each([](std::size_t index, int old_value, int new_value){
+            std::cout << "[" << index << "] " << old_value << " -> " << new_value << std::endl;
+        }, list);
+
+        list[1] = 10;
+        list[4] = 40;
+        list[1] = 11;
+
+        unsubscribe();
+        list[2] = 20;
+    }
+
+    void test_reduce(){
+        std::vector<reactive::ObservableProperty<double>> list;
+        for (int i = 0; i < 10'000; ++i) {
+            list.emplace_back(1.0);
+        }
+
+        reactive::ReactiveProperty<double> sum;
+        sum.reduce(0.0
+            , [](double& sum, double value){ sum += value; }
+            , [](double& sum, double value){ sum -= value; }
+            , list
+        );
+        std::cout << "sum = " << sum.getCopy() << std::endl;
+
+        list[0] = 3.0;
+        list[9'999] = 0.0;
+        std::cout << "sum = " << sum.getCopy() << std::endl;
+
+        sum = 0.0;
+        list[1] = 100.0;
+        std::cout << "sum = " << sum.getCopy() << std::endl;
+    }
+
+    // re-reduce blocking property, while inputs written from other thread
+    void test_reduce_threaded(){
+        std::vector<reactive::ObservableProperty<long long>> list;
+        for (int i = 0; i < 4'000; ++i) {
+            list.emplace_back(1);
+        }
+
+        reactive::ReactiveProperty<long long, reactive::blocking> sum;
+        auto reduce = [&](){
+            sum.reduce(0
+                , [](long long& sum, long long value){ sum += value; }
+                , [](long long& sum, long long value){ sum -= value; }
+                , list
+            );
+        };
+
+        std::atomic<bool> stop{false};
+        std::thread writer([&]() {
+            for (long long i = 0; !stop.load(); ++i) {
+                list[i % list.size()] = i;
+            }
+        });
+        for (int i = 0; i < 20; ++i) {
+            reduce();
+        }
+        stop = true;
+        writer.join();
+
+        long long expected = 0;
+        for (const auto& value : list) {
+            expected += value.getCopy();
+        }
+        std::cout << "reduce threaded ok = " << (sum.getCopy() == expected) << std::endl;   // 1
+    }
+
+    void test_reentrant(){
+        std::vector<reactive::ObservableProperty<int>> list;
+        list.emplace_back(0);
+        list.emplace_back(0);
+
+        // change from closure queued, and applied after closure returns
+        auto unsubscribe = reactive::observe_each([&](std::size_t index, int old_value, int new_value){
+            std::cout << "[" << index << "] " << old_value << " -> " << new_value << std::endl;
+            if (index == 0) {
+                list[1] = new_value * 2;
+            }
+        }, list);
+
+        list[0] = 5;
+        unsubscribe();
+    }
+
+    void test_all(){
+        test_observe_each();
+        test_reduce();
+        test_reduce_threaded();
+        test_reentrant();
+    }
+};
+
+#endif //TEST_TESTDYNAMICOBSERVER_H
@@ -0,0 +1,72 @@
+#ifndef TEST_TESTEXPRESSION_H
+#define TEST_TESTEXPRESSION_H
+
+#include <iostream>
+
+#include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
+#include <reactive/ObservableVector.h>
+
+class TestExpression{
+public:
+    void test_simple(){
+        reactive::ObservableProperty<int> x1 = 1;
+        reactive::ObservableProperty<int> x2 = 2;
+        reactive::ObservableProperty<int> x3 = 3;
+
+        reactive::ReactiveProperty<int> sum = x1 + x2 * x3;
+        sum += [](int sum){
+            std::cout << "sum = " << sum << std::endl;
+        };
+        std::cout << sum.getCopy() << std::endl;
+
+        x1 = 10;
+        x3 = 4;
+    }
+
+    void test_constants(){
+        reactive::ObservableProperty<double> x = 2.0;
+        reactive::ReactiveProperty<double> y;
+
+        y = -x * 3.0 + 1;
+        std::cout << y.getCopy() << std::endl;
+
+        x = 1.0;
+        std::cout << y.getCopy() << std::endl;
+    }
+
+    void test_chain(){
+        reactive::ObservableProperty<long long> x1 = 1;
+        reactive::ObservableProperty<long long> x2 = 2;
+
+        auto s = x1 + x2;
+        auto sum  = reactive::make_reactive(s);
+        auto less = reactive::make_reactive(sum < x1 * 2);
+
+        std::cout << sum.getCopy() << " " << less.getCopy() << std::endl;
+
+        x2 = -10;
+        std::cout << sum.getCopy() << " " << less.getCopy() << std::endl;
+    }
+
+    // only property handles are operands - no arithmetic on other observables
+    void test_operands(){
+        using reactive::details::expression::is_operand;
+        static_assert(is_operand<reactive::ObservableProperty<int>>::value, "");
+        static_assert(is_operand<reactive::ReactiveProperty<int>>::value, "");
+        static_assert(!is_operand<reactive::ObservableVector<int>>::value, "");
+        static_assert(!is_operand<int>::value, "");
+
+        reactive::ObservableProperty<int> x = 2;
+        std::cout << "operands " << reactive::make_reactive(-x * 3).getCopy() << std::endl;    // -6
+    }
+
+    void test_all(){
+        test_simple();
+        test_constants();
+        test_chain();
+        test_operands();
+    }
+};
+
+#endif //TEST_TESTEXPRESSION_H
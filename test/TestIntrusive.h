@@ -0,0 +1,149 @@
+#ifndef TEST_TESTINTRUSIVE_H
+#define TEST_TESTINTRUSIVE_H
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <memory>
+
+#include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
+#include <reactive/intrusive/ObservableProperty.h>
+#include <reactive/intrusive/ReactiveProperty.h>
+#include <reactive/non_thread_safe/ObservableProperty.h>
+#include <reactive/non_thread_safe/ReactiveProperty.h>
+#include <reactive/Transaction.h>
+#include <reactive/observer.h>
+#include <reactive/bind.h>
+
+class TestIntrusive{
+public:
+    void test_pointer(){
+        using namespace reactive::intrusive;
+        weak_ptr<std::vector<int>> weak;
+        {
+            auto strong = make_shared<std::vector<int>>(3, 1);
+            weak = strong;
+            auto copy = strong;
+            std::cout << "sizeof = " << sizeof(strong) << ", use_count = " << strong.use_count() << std::endl;  // 8, 2
+            std::cout << "locked size = " << weak.lock()->size() << std::endl;   // 3
+        }
+        std::cout << "expired = " << weak.expired() << ", locked = " << bool(weak.lock()) << std::endl;        // 1, 0
+    }
+
+    void test_observe(){
+        reactive::intrusive::ObservableProperty<int> x = 1;
+        reactive::ObservableProperty<int> y = 2;
+
+        reactive::observe([](int x, int y){
+            std::cout << "x + y = " << x + y << std::endl;
+        }, x, y);
+
+        x = 10;                     // x + y = 12
+        y = 20;                     // x + y = 30
+    }
+
+    void test_reactive(){
+        reactive::intrusive::ObservableProperty<int> x = 1;
+        reactive::ObservableProperty<int> y = 2;
+
+        reactive::ReactiveProperty<int> sum;
+        sum.set([](int x, int y){ return x + y; }, x, y);
+
+        reactive::intrusive::ReactiveProperty<int> product;
+        product.set([](int sum){ return sum * 10; }, sum);
+        product += [](int product){
+            std::cout << "product = " << product << std::endl;
+        };
+
+        x = 2;                      // product = 40
+        y = 3;                      // product = 50
+        std::cout << "sum = " << sum.getCopy() << std::endl;    // 5
+    }
+
+    void test_bind(){
+        struct Label {
+            int shown = 0;
+        };
+        auto label = std::make_shared<Label>();
+
+        reactive::intrusive::ObservableProperty<int> x;
+        auto unbind = reactive::bind(label, [](auto label, int x){
+            label->shown = x;
+        }, x);
+
+        x = 42;
+        std::cout << "label shown = " << label->shown << std::endl;    // 42
+        unbind();
+        x = 43;
+        std::cout << "label shown = " << label->shown << std::endl;    // 42
+    }
+
+    void test_lifetime(){
+        reactive::intrusive::ReactiveProperty<int> sum;
+        {
+            reactive::intrusive::ObservableProperty<int> x = 1;
+            sum.set([](int x){ return x + 1; }, x);
+            x = 2;
+        }
+        // source destroyed, observer's weak pointer expired
+        std::cout << "sum = " << sum.getCopy() << std::endl;    // 3
+    }
+
+    void test_threaded(){
+        reactive::intrusive::ObservableProperty<int> x{ 0 };
+        reactive::intrusive::ReactiveProperty<long long> total{ 0 };
+        total.update([](long long& total, int x){ total += x; }, x);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < 10000; ++i) {
+                    reactive::intrusive::ObservableProperty<int> copy{ x.weak_ptr() };
+                    copy = i % 2;
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        std::cout << "threaded total > 0 = " << (total.getCopy() > 0) << std::endl;
+    }
+
+    // non_thread_safe - intrusive::pointer<false>, observers of them too
+    void test_non_thread_safe(){
+        reactive::non_thread_safe::ObservableProperty<std::string> name{"a"};
+        reactive::non_thread_safe::ObservableProperty<int> count{1};
+
+        reactive::non_thread_safe::ReactiveProperty<std::string> label;
+        label.set([](const std::string& name, int count){
+            return name + ":" + std::to_string(count);
+        }, name, count);
+
+        reactive::ReactiveProperty<std::size_t> length;     // threaded, nonblocking over non-threaded
+        length.set([](const std::string& label){ return label.size(); }, label);
+
+        reactive::observe([](const std::string& label){
+            std::cout << "label = " << label << std::endl;
+        }, label);
+
+        name = std::string("abc");  // label = abc:1
+        {
+            reactive::Transaction transaction;
+            name  = std::string("x");
+            count = 10;
+        }                           // label = x:10
+        std::cout << "length = " << length.getCopy() << ", label use_count = " << label.shared_ptr().use_count() << std::endl;    // 4, 2
+    }
+
+    void test_all(){
+        test_pointer();
+        test_observe();
+        test_reactive();
+        test_bind();
+        test_lifetime();
+        test_threaded();
+        test_non_thread_safe();
+    }
+};
+
+#endif //TEST_TESTINTRUSIVE_H
@@ -0,0 +1,137 @@
+#ifndef TEST_TESTMAPVIEW_H
+#define TEST_TESTMAPVIEW_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+
+#include <reactive/ObservableMap.h>
+#include <reactive/MapView.h>
+
+class TestMapView{
+    template<class Range>
+    static void print(const Range& range){
+        range.foreach([](const std::string& key, int value){
+            std::cout << key << ":" << value << " ";
+        });
+        std::cout << std::endl;
+    }
+
+    // Consumer keys, patched with rank diff
+    struct Mirror {
+        std::vector<int> keys;
+
+        template<class Range>
+        void apply(const reactive::VectorDiff& diff, const Range& range){
+            std::vector<bool> dirty(keys.size(), false);
+            for (const auto& change : diff) {
+                switch (change.kind) {
+                    case reactive::VectorChange::insert:
+                        keys.insert(keys.begin() + change.first, change.last - change.first, -1);
+                        dirty.insert(dirty.begin() + change.first, change.last - change.first, true);
+                        break;
+                    case reactive::VectorChange::erase:
+                        keys.erase(keys.begin() + change.first, keys.begin() + change.last);
+                        dirty.erase(dirty.begin() + change.first, dirty.begin() + change.last);
+                        break;
+                    case reactive::VectorChange::update:
+                        std::fill(dirty.begin() + change.first, dirty.begin() + change.last, true);
+                        break;
+                }
+            }
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                if (dirty[i]) keys[i] = range.key(i);
+            }
+        }
+    };
+public:
+    void test_simple(){
+        reactive::ObservableMap<std::string, int> scores;
+        scores.set("a", 5);
+        scores.set("b", 1);
+
+        auto passed = reactive::filtered(scores, [](int score){ return score >= 3; });
+        auto ranking = reactive::top_k(reactive::filtered(passed, [](int score){ return score < 100; })
+                                      , 2, std::greater<int>());
+
+        passed += [](const reactive::MapDiff<std::string>& diff){
+            std::cout << "passed changed " << diff.size() << std::endl;
+        };
+        ranking += [](const reactive::VectorDiff& diff, const auto& range){
+            std::cout << "top changes " << diff.size() << ": ";
+            print(range);
+        };
+
+        // views subscribed to passed first - notified before us
+        scores.set("c", 7);         // top changes 1: c:7 a:5, passed changed 1
+        scores.set("b", 2);         // below filter - nothing
+        scores.set("d", 6);         // top changes 2: c:7 d:6, passed changed 1
+        scores.set("c", 500);       // top changes 2: d:6 a:5, passed changed 1
+        scores.erase("d");          // top changes 1: a:5, passed changed 1
+
+        std::cout << "passed size = " << passed.size() << std::endl;
+        print(reactive::sorted(scores).lock());             // b:2 a:5 c:500
+    }
+
+    void test_mirror(){
+        reactive::ObservableMap<int, int> map;
+        auto sorted = reactive::sorted(map);
+        auto top    = reactive::top_k(map, 10, std::greater<int>());
+
+        Mirror sorted_mirror, top_mirror;
+        sorted += [&](const reactive::VectorDiff& diff, const auto& range){ sorted_mirror.apply(diff, range); };
+        top    += [&](const reactive::VectorDiff& diff, const auto& range){ top_mirror.apply(diff, range); };
+
+        std::mt19937 rng(7);
+        for (int i = 0; i < 5000; ++i) {
+            const int key = rng() % 200;
+            if (rng() % 4 == 0) {
+                map.erase(key);
+            } else if (rng() % 2) {
+                map.set(key, int(rng() % 50));
+            } else {
+                auto batch = map.batch();
+                batch.set(key, int(rng() % 50));
+                batch.erase(int(rng() % 200));
+                batch.set(int(rng() % 200), int(rng() % 50));
+            }
+        }
+
+        auto expected = [](const auto& view){
+            std::vector<int> keys;
+            view.lock().foreach([&](int key, int){ keys.push_back(key); });
+            return keys;
+        };
+        std::cout << "sorted mirror equal = " << (sorted_mirror.keys == expected(sorted))
+                  << ", top mirror equal = "  << (top_mirror.keys == expected(top))
+                  << ", top size = " << top_mirror.keys.size() << std::endl;
+
+        // keys count around k - window full, rank moves inside it
+        reactive::ObservableMap<int, int> small;
+        auto small_top = reactive::top_k(small, 2);
+        Mirror small_mirror;
+        bool sizes_equal = true;
+        small_top += [&](const reactive::VectorDiff& diff, const auto& range){
+            small_mirror.apply(diff, range);
+            sizes_equal = sizes_equal && small_mirror.keys.size() == range.size();
+        };
+        for (int i = 0; i < 2000; ++i) {
+            const int key = rng() % 3;
+            if (rng() % 5 == 0) {
+                small.erase(key);
+            } else {
+                small.set(key, int(rng() % 10));
+            }
+        }
+        std::cout << "small top mirror equal = " << (small_mirror.keys == expected(small_top))
+                  << ", sizes equal = " << sizes_equal << std::endl;
+    }
+
+    void test_all(){
+        test_simple();
+        test_mirror();
+    }
+};
+
+#endif //TEST_TESTMAPVIEW_H
@@ -1,8 +1,13 @@
 #ifndef TEST_TESTMULTIOBSERVER_H
 #define TEST_TESTMULTIOBSERVER_H
 
+#include <thread>
+#include <vector>
+#include <atomic>
+
 #include <reactive/observer.h>
 #include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
 
 
 /*
@@ -85,9 +90,75 @@ public:
 
 	}
 
+	// blocking observers, over same properties in different order, writers in many threads
+	void test_blocking_threaded() {
+		using Property = reactive::ObservableProperty<long long, reactive::blocking>;
+		Property a = 0;
+		Property b = 0;
+		Property c = 0;
+
+		std::atomic<int> runs_ab{0}, runs_ba{0}, runs_bac{0}, runs_ca{0};
+		reactive::observe<reactive::blocking>([&](long long, long long) { runs_ab++; }, a, b);
+		reactive::observe<reactive::blocking>([&](long long, long long) { runs_ba++; }, b, a);
+		reactive::observe<reactive::blocking>([&](long long, long long, long long) { runs_bac++; }, b, a, c);
+		reactive::observe<reactive::blocking>([&](long long, long long) { runs_ca++; }, c, a);
+
+		// blocking ReactiveProperty, re-set concurrently with writes (get_mutex vs observable locks order)
+		reactive::ReactiveProperty<long long, reactive::blocking> sum;
+		sum.set([](long long a, long long b) { return a + b; }, a, b);
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 4; t++) {
+			threads.emplace_back([&, t]() {
+				for (int i = 0; i < 10'000; i++) {
+					// unique values - each write is a change
+					const long long value = t * 100'000 + i + 1;
+					if ((i + t) % 2) {
+						a = value;
+					} else {
+						b = value;
+					}
+				}
+			});
+		}
+		threads.emplace_back([&]() {
+			for (int i = 0; i < 1'000; i++) {
+				if (i % 2) {
+					sum.set([](long long a, long long b) { return a + b; }, a, b);
+				} else {
+					sum.set([](long long b, long long a) { return b + a; }, b, a);
+				}
+			}
+		});
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		std::cout << "blocking threaded runs = " << runs_ab << " " << runs_ba << " " << runs_bac << " " << runs_ca     // 40000 40000 40000 20000
+			<< ", sum ok = " << (sum.getCopy() == a.getCopy() + b.getCopy()) << std::endl;                              // 1
+	}
+
+	// opt-in lock-free value slots
+	void test_atomic_slots() {
+		reactive::ObservableProperty<long long, reactive::nonblocking> x = 1;
+		reactive::ObservableProperty<long long, reactive::nonblocking> y = 2;
+
+		long long sum = 0;
+		auto unsubscribe = reactive::observe<reactive::nonblocking_atomic>([&](long long x, long long y) {
+			sum = x + y;
+		}, x, y);
+
+		x = 10;
+		y = 20;
+		std::cout << "atomic slots sum = " << sum << std::endl;		// 30
+		unsubscribe();
+	}
+
     void test_all(){
         //test_simple();
 		test_self_unsubscribe();
+		test_blocking_threaded();
+		test_atomic_slots();
     }
 };
 
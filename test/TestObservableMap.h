@@ -0,0 +1,85 @@
+#ifndef TEST_TESTOBSERVABLEMAP_H
+#define TEST_TESTOBSERVABLEMAP_H
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include <reactive/ObservableMap.h>
+
+class TestObservableMap{
+public:
+    void test_simple(){
+        reactive::ObservableMap<int, std::string> map;
+
+        auto unsubscribe = map.subscribe(2, [](int key, const std::string* value){
+            std::cout << "key " << key << " = " << (value ? *value : "erased") << std::endl;
+        });
+        map += [](const reactive::MapDiff<int>& diff){
+            std::cout << "bulk " << diff.size() << " keys" << std::endl;
+        };
+
+        map.set(1, "one");                  // bulk 1 keys
+        map.set(2, "two");                  // key 2 = two, bulk 1 keys
+        map.set(2, "two");
+        {
+            auto batch = map.batch();
+            batch.set(3, "three");
+            batch.update(2, [](std::string& value){ value += "!"; });   // key 2 = two!
+            batch.erase(1);
+        }                                   // bulk 3 keys
+        map.erase(2);                       // key 2 = erased, bulk 1 keys
+        unsubscribe();
+        map.set(2, "again");                // bulk 1 keys
+
+        std::cout << "size = " << map.size() << " contains 1 = " << map.contains(1)
+                  << " get 3 = " << *map.get(3) << std::endl;    // 2 0 three
+    }
+
+    // repeated unsubscribe does not drop other subscribers of key
+    void test_unsubscribe_twice(){
+        reactive::ObservableMap<int, int> map;
+        auto a = map.subscribe(1, [](int, const int*){ std::cout << "a" << std::endl; });
+        auto b = map.subscribe(1, [](int, const int* value){ std::cout << "b " << *value << std::endl; });
+
+        a();
+        a();
+        map.set(1, 10);                     // b 10
+        b();
+        map.set(1, 20);
+    }
+
+    void test_threaded(){
+        reactive::ObservableMap<int, int> map;
+        std::atomic<int> key_events{0};
+        std::vector<reactive::Subscription> subscriptions;
+        for (int key = 0; key < 100; key += 10) {
+            subscriptions.push_back(map.subscribe(key, [&](int, const int*){ key_events++; }));
+        }
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < 10000; ++i) {
+                    map.set(i % 1000, i);
+                    if (i % 7 == t) map.erase(i % 1000);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        for (auto& unsubscribe : subscriptions) unsubscribe();
+
+        std::cout << "threaded done, size <= 1000 = " << (map.size() <= 1000)
+                  << ", key events > 0 = " << (key_events > 0) << std::endl;
+    }
+
+    void test_all(){
+        test_simple();
+        test_unsubscribe_twice();
+        test_threaded();
+    }
+};
+
+#endif //TEST_TESTOBSERVABLEMAP_H
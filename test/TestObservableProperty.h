@@ -3,6 +3,11 @@
 
 #include <iostream>
 #include <thread>
+#include <vector>
+#include <atomic>
+#include <string>
+#include <array>
+#include <memory>
 
 #include <reactive/ObservableProperty.h>
 
@@ -185,6 +190,166 @@ public:
 		std::cout << vec2->x << std::endl;		
 	}
 
+    void test_wait(){
+        reactive::ObservableProperty<int> stage{0};
+        reactive::ObservableProperty<std::vector<int>, reactive::blocking> list;
+
+        std::thread worker{[&]() {
+            const int s = stage.wait_until([](int stage){ return stage >= 2; });
+            std::cout << "stage = " << s << std::endl;      // 2
+
+            const unsigned version = list.version();
+            list.write_lock()->push_back(s);
+            list.wait_for_change(version + 1);              // wait for main thread write
+            std::cout << "list size = " << list.getCopy().size() << std::endl;    // 2
+        }};
+
+        for (int i = 1; i <= 3; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            stage = i;
+        }
+
+        list.wait_until([](const std::vector<int>& list){ return !list.empty(); });
+        list.write_lock()->push_back(0);
+
+        worker.join();
+    }
+
+    void test_atomic_rmw(){
+        reactive::ObservableProperty<int, reactive::nonblocking_atomic> counter{0};
+        std::atomic<int> events{0};
+        counter += [&](int){ events++; };
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < 10000; ++i) counter.fetch_add(1);
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        std::cout << "counter = " << counter.getCopy() << " events = " << events << std::endl;    // 40000 40000
+
+        events = 0;
+        counter.fetch_sub(0);                                       // no event
+        std::cout << "exchange " << counter.exchange(5) << std::endl;    // 40000
+        int expected = 4;
+        std::cout << counter.compare_exchange(expected, 6) << " " << expected << std::endl;    // 0 5
+        std::cout << counter.compare_exchange(expected, 6) << std::endl;                       // 1
+        std::cout << "modify " << counter.modify([](int& i){ i *= 2; }) << std::endl;          // 12
+        std::cout << "events = " << events << std::endl;            // 3
+
+        // not default constructible
+        struct Ticks {
+            int value;
+            explicit Ticks(int value) : value(value) {}
+        };
+        reactive::ObservableProperty<Ticks, reactive::nonblocking_atomic, true, reactive::change_detection::always> ticks{ Ticks(1) };
+        std::cout << "ticks " << ticks.modify([](Ticks& t){ t.value += 2; }).value << std::endl;   // 3
+    }
+
+    struct SameSign {
+        bool operator()(int old_value, int new_value) const {
+            return (old_value < 0) != (new_value < 0);
+        }
+    };
+    void test_change_detection(){
+        using namespace reactive::change_detection;
+        int events = 0;
+        auto count = [&](auto&&){ events++; };
+
+        reactive::ObservableProperty<int, reactive::default_blocking, true, always> a{1};
+        a += count;
+        a = 1;
+        a = 1;
+        std::cout << "always " << events << std::endl;      // 2
+
+        events = 0;
+        reactive::ObservableProperty<std::string, reactive::blocking, true, hash> s{"abc"};
+        s += count;
+        s = std::string("abc");
+        s = std::string("abd");
+        s.write_lock()->append("e");                    // abde
+        s = std::string("abde");
+        s = std::string("abc");
+        std::cout << "hash " << events << std::endl;        // 3
+
+        events = 0;
+        reactive::ObservableProperty<float, reactive::default_blocking, true, epsilon<std::ratio<1, 100>>> f{1.0f};
+        f += count;
+        f = 1.001f;
+        f = 1.5f;
+        f = 1.504f;                     // slow ramp - compared with last notified 1.5
+        f = 1.508f;
+        f = 1.512f;
+        std::cout << "epsilon " << events << " " << f.getCopy() << std::endl;      // 2 1.512
+
+        events = 0;
+        reactive::ObservableProperty<int, reactive::nonblocking, true, functor<SameSign>> sign{1};
+        sign += count;
+        sign = 5;
+        sign = -5;
+        sign = -1;
+        std::cout << "functor " << events << std::endl;     // 1
+
+        events = 0;
+        reactive::ObservableProperty<int, reactive::nonblocking_atomic, true, functor<SameSign>> atomic_sign{1};
+        atomic_sign += count;
+        atomic_sign.fetch_add(5);                       // same sign - no event
+        atomic_sign.fetch_sub(10);
+        std::cout << "functor fetch_add " << events << std::endl;     // 1
+
+        events = 0;
+        using Data = std::shared_ptr<const std::vector<int>>;
+        reactive::ObservableProperty<Data, reactive::blocking, true, identity> v{ std::make_shared<const std::vector<int>>(3, 1) };
+        v += count;
+        v = v.getCopy();                                // same pointee
+        v = std::make_shared<const std::vector<int>>(3, 1);    // other object, equal contents
+        std::cout << "identity " << events << std::endl;    // 1
+
+        events = 0;
+        reactive::ObservableProperty<double, reactive::nonblocking_atomic, true, epsilon<std::ratio<1, 2>>> d{0.0};
+        d += count;
+        d.write_lock().get() = 10.0;                    // WriteLock always triggers, and resets last notified
+        d = 0.1;
+        std::cout << "epsilon atomic " << events << std::endl;     // 2
+    }
+
+    void test_bitwise(){
+        using Samples = std::array<float, 64>;
+        reactive::ObservableProperty<Samples, reactive::blocking, true, reactive::change_detection::bitwise_range> samples{ Samples{} };
+        samples += [&](const Samples&){
+            const auto range = samples.changed_range();
+            std::cout << "changed [" << range.first << ", " << range.last << ")" << std::endl;
+        };
+
+        Samples value{};
+        value[3] = 1;
+        value[10] = 2;
+        samples = value;                    // changed [3, 11)
+        samples = value;
+        value[63] = 1;
+        samples = value;                    // changed [63, 64)
+        samples.write_lock()->at(0) = 5;    // changed [0, 64)
+    }
+
+    // event list allocated by first subscriber, while others subscribe and write concurrently
+    void test_lazy_event(){
+        reactive::ObservableProperty<int, reactive::nonblocking> i{0};
+        i = 1;                              // nobody subscribed - no event
+
+        std::atomic<int> events{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&]() {
+                i += [&](int){ events++; };
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        i = 2;
+        std::cout << "lazy events " << events << std::endl;     // 4
+    }
+
     void test_all(){
         //test_simple();
 		//test_unsubscribe();
@@ -193,6 +358,11 @@ public:
         //test_write_lock();
         //test_copy();
         //test_silent();
+        //test_wait();
+        //test_atomic_rmw();
+        //test_change_detection();
+        //test_bitwise();
+        //test_lazy_event();
 
 		test_nontreadsafe();
 
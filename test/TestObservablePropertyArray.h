@@ -0,0 +1,105 @@
+#ifndef TEST_TESTOBSERVABLEPROPERTYARRAY_H
+#define TEST_TESTOBSERVABLEPROPERTYARRAY_H
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <memory>
+
+#include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
+#include <reactive/ObservablePropertyArray.h>
+#include <reactive/observer.h>
+#include <reactive/bind.h>
+#include <reactive/Transaction.h>
+
+class TestObservablePropertyArray{
+public:
+    void test_simple(){
+        reactive::ObservablePropertyArray<int> xs(1'000'000, 1);
+        auto x = xs[10];
+        auto y = xs[999'999];
+
+        reactive::observe([](int x, int y){
+            std::cout << "x + y = " << x + y << std::endl;
+        }, x, y);
+
+        reactive::ReactiveProperty<int> product;
+        product.set([](int x, int y){ return x * y; }, x, y);
+        product += [](int product){
+            std::cout << "product = " << product << std::endl;
+        };
+
+        x = 2;                      // x + y = 3, product = 2
+        y = 3;                      // x + y = 5, product = 6
+        xs.set(500, 7);             // not observed - nothing
+        xs[10].modify([](int& x){ x += 2; });   // x + y = 7, product = 12
+
+        std::cout << "xs[500] = " << xs.get(500) << std::endl;
+    }
+
+    void test_bind(){
+        struct Label {
+            int shown = 0;
+        };
+        auto label = std::make_shared<Label>();
+
+        reactive::ObservablePropertyArray<int> xs(4);
+        auto unbind = reactive::bind(label, [](auto label, int x){
+            label->shown = x;
+        }, xs[2]);
+
+        xs.set(2, 42);
+        std::cout << "label shown = " << label->shown << std::endl;    // 42
+        unbind();
+        xs.set(2, 43);
+        std::cout << "label shown = " << label->shown << std::endl;    // 42
+    }
+
+    void test_transaction(){
+        reactive::ObservablePropertyArray<int> xs(4);
+        reactive::observe([](int a, int b){
+            std::cout << "a, b = " << a << ", " << b << std::endl;
+        }, xs[0], xs[1]);
+
+        {
+            reactive::Transaction transaction;
+            xs.set(0, 1);
+            xs.set(1, 2);
+            xs.set(0, 3);
+        }                           // a, b = 3, 2
+    }
+
+    void test_threaded(){
+        reactive::ObservablePropertyArray<int> xs(1024);
+        auto sum = std::make_shared<std::atomic<long long>>(0);
+        std::vector<reactive::Subscription> subscriptions;
+        for (std::size_t i = 0; i < xs.size(); i += 64) {
+            subscriptions.push_back(reactive::observe([sum](int x){ *sum += x; }, xs[i]));
+        }
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < 10000; ++i) {
+                    xs.modify((i * 4 + t) % xs.size(), [](int& x){ x++; });
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        for (auto& unsubscribe : subscriptions) unsubscribe();
+
+        long long total = 0;
+        for (std::size_t i = 0; i < xs.size(); ++i) total += xs.get(i);
+        std::cout << "threaded total = " << total << ", observed sum > 0 = " << (*sum > 0) << std::endl;   // 40000
+    }
+
+    void test_all(){
+        test_simple();
+        test_bind();
+        test_transaction();
+        test_threaded();
+    }
+};
+
+#endif //TEST_TESTOBSERVABLEPROPERTYARRAY_H
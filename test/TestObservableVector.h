@@ -0,0 +1,123 @@
+#ifndef TEST_TESTOBSERVABLEVECTOR_H
+#define TEST_TESTOBSERVABLEVECTOR_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+
+#include <reactive/ObservableVector.h>
+
+class TestObservableVector{
+    static const char* kind_name(reactive::VectorChange::Kind kind){
+        switch (kind) {
+            case reactive::VectorChange::insert: return "insert";
+            case reactive::VectorChange::erase:  return "erase";
+            default: return "update";
+        }
+    }
+
+    static void print(const reactive::VectorDiff& diff){
+        for (const auto& change : diff) {
+            std::cout << kind_name(change.kind) << " [" << change.first << ", " << change.last << ") ";
+        }
+        std::cout << std::endl;
+    }
+
+    // Consumer state, patched with diff: structure first, then dirty elements from final vector.
+    template<class T>
+    struct Mirror {
+        std::vector<T> values;
+        long long copied = 0;
+
+        void apply(const reactive::VectorDiff& diff, const std::vector<T>& source){
+            std::vector<bool> dirty(values.size(), false);
+            for (const auto& change : diff) {
+                switch (change.kind) {
+                    case reactive::VectorChange::insert:
+                        values.insert(values.begin() + change.first, change.last - change.first, T{});
+                        dirty.insert(dirty.begin() + change.first, change.last - change.first, true);
+                        break;
+                    case reactive::VectorChange::erase:
+                        values.erase(values.begin() + change.first, values.begin() + change.last);
+                        dirty.erase(dirty.begin() + change.first, dirty.begin() + change.last);
+                        break;
+                    case reactive::VectorChange::update:
+                        std::fill(dirty.begin() + change.first, dirty.begin() + change.last, true);
+                        break;
+                }
+            }
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                if (!dirty[i]) continue;
+                values[i] = source[i];
+                copied++;
+            }
+        }
+    };
+public:
+    void test_simple(){
+        reactive::ObservableVector<std::string> list{"a", "b", "c"};
+        list += [](const reactive::VectorDiff& diff, const std::vector<std::string>&){
+            print(diff);
+        };
+
+        {
+            auto w = list.write_lock();
+            w.push_back("d");
+            w.push_back("e");           // insert [3, 5)
+            w.set(0, "A");
+            w.modify(1) += "B";         // update [0, 2)
+            w.erase(2);
+        }
+        // insert [3, 5) update [0, 2) erase [2, 3)
+        {
+            auto w = list.write_lock();
+            w.pop_back();
+            w.pop_back();
+        }
+        // erase [2, 4)
+        list.write_lock();              // no changes - no event
+        {
+            auto w = list.write_lock();
+            w.unlock();                 // no changes - released too
+            std::cout << "size after unlock = " << list.getCopy().size() << std::endl;    // 2
+        }
+
+        for (const auto& s : list.getCopy()) std::cout << s << " ";     // A bB
+        std::cout << std::endl;
+    }
+
+    void test_mirror(){
+        reactive::ObservableVector<int> list;
+        Mirror<int> mirror;
+        list += [&](const reactive::VectorDiff& diff, const std::vector<int>& values){
+            mirror.apply(diff, values);
+        };
+
+        std::mt19937 rng(42);
+        for (int scope = 0; scope < 200; ++scope) {
+            auto w = list.write_lock();
+            const int edits = 1 + rng() % 5;
+            for (int e = 0; e < edits; ++e) {
+                const std::size_t size = w.size();
+                switch (rng() % 4) {
+                    case 0: w.insert(size ? rng() % (size + 1) : 0, int(rng() % 1000)); break;
+                    case 1: if (size) w.erase(rng() % size); break;
+                    case 2: if (size) w.set(rng() % size, int(rng() % 1000)); break;
+                    case 3: w.push_back(int(rng() % 1000)); break;
+                }
+            }
+        }
+
+        std::cout << "mirror equal = " << (mirror.values == list.getCopy())
+                  << ", size = " << mirror.values.size()
+                  << ", copied = " << mirror.copied << std::endl;
+    }
+
+    void test_all(){
+        test_simple();
+        test_mirror();
+    }
+};
+
+#endif //TEST_TESTOBSERVABLEVECTOR_H
@@ -0,0 +1,127 @@
+#ifndef TEST_TESTOPERATORS_H
+#define TEST_TESTOPERATORS_H
+
+#include <iostream>
+#include <vector>
+
+#include <reactive/operators.h>
+#include <reactive/Event.h>
+#include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
+
+class TestOperators{
+public:
+    void test_map_filter(){
+        using namespace reactive::operators;
+
+        reactive::ObservableProperty<int> x = 1;
+
+        reactive::ReactiveProperty<int> y = from(x)
+            | map([](int x){ return x * 10; })
+            | filter([](int x){ return x < 100; })
+            | map([](int x){ return x + 1; });
+        std::cout << "y = " << y.getCopy() << std::endl;        // 11
+
+        x = 5;
+        std::cout << "y = " << y.getCopy() << std::endl;        // 51
+        x = 20;
+        std::cout << "y = " << y.getCopy() << std::endl;        // 51
+    }
+
+    void test_scan_distinct(){
+        using namespace reactive::operators;
+
+        reactive::Event<int> clicks;
+
+        std::vector<int> out;
+        auto unsubscribe = (from(clicks)
+            | map([](int i){ return i / 2; })
+            | distinct_until_changed()
+            | scan(0, [](int acc, int i){ return acc + i; })
+        ).subscribe([&](int sum){ out.push_back(sum); });
+
+        for (int i = 0; i < 6; ++i) {
+            clicks(i);          // 0 0 1 1 2 2
+        }
+        unsubscribe();
+        clicks(100);
+
+        for (int i : out) std::cout << i << " ";                // 0 1 3
+        std::cout << std::endl;
+    }
+
+    void test_buffer_sample(){
+        using namespace reactive::operators;
+
+        reactive::ObservableProperty<int> x = 0;
+        reactive::ObservableProperty<int> tick = 0;
+
+        reactive::ReactiveProperty<int> sampled = from(x) | sample(tick);
+        std::vector<std::vector<int>> buffers;
+        auto unsubscribe = (from(x) | buffer_count(3)).subscribe([&](const std::vector<int>& buffer){
+            buffers.push_back(buffer);
+        });
+
+        for (int i = 1; i <= 7; ++i) {
+            x = i;
+            if (i == 4) tick = 1;
+        }
+        std::cout << "sampled = " << sampled.getCopy() << std::endl;      // 4
+        tick = 2;
+        std::cout << "sampled = " << sampled.getCopy() << std::endl;      // 7
+
+        for (const auto& buffer : buffers) {                    // (0 1 2) (3 4 5)
+            std::cout << "(";
+            for (int i : buffer) std::cout << i << " ";
+            std::cout << ") ";
+        }
+        std::cout << std::endl;
+        unsubscribe();
+    }
+
+    void test_latest(){
+        using namespace reactive::operators;
+
+        reactive::ObservableProperty<int> x = 1;
+        reactive::ObservableProperty<int> y = 10;
+
+        reactive::ReactiveProperty<int> combined = from(x) | combine_latest([](int x, int y){ return x + y; }, y);
+        reactive::ReactiveProperty<int> with_latest = from(x) | with_latest_from([](int x, int y){ return x + y; }, y);
+        std::cout << combined.getCopy() << " " << with_latest.getCopy() << std::endl;     // 11 11
+
+        y = 20;
+        std::cout << combined.getCopy() << " " << with_latest.getCopy() << std::endl;     // 21 11
+
+        x = 2;
+        std::cout << combined.getCopy() << " " << with_latest.getCopy() << std::endl;     // 22 22
+    }
+
+    void test_reentrant(){
+        using namespace reactive::operators;
+
+        reactive::ObservableProperty<int> p = 0;
+
+        // write from closure queued, and passed after closure returns
+        std::vector<int> out;
+        auto unsubscribe = (from(p)
+            | scan(0, [](int acc, int i){ return acc + i; })
+        ).subscribe([&](int acc){
+            out.push_back(acc);
+            if (acc < 3) p = acc + 1;
+        });
+        unsubscribe();
+
+        for (int i : out) std::cout << i << " ";                // 0 1 3
+        std::cout << std::endl;
+    }
+
+    void test_all(){
+        test_map_filter();
+        test_scan_distinct();
+        test_buffer_sample();
+        test_latest();
+        test_reentrant();
+    }
+};
+
+#endif //TEST_TESTOPERATORS_H
@@ -2,6 +2,8 @@
 #define TEST_TESTREACTIVEPROPERTY_H
 
 #include <reactive/ReactiveProperty.h>
+#include <functional>
+#include <vector>
 
 
 class TestReactiveProperty{
@@ -64,6 +66,58 @@ public:
         vec2->first;
 	}
 
+    void test_rebind(){
+        reactive::ObservableProperty<int> x = 1;
+        reactive::ReactiveProperty<int> scaled;
+
+        // same closure type, same observables - closure swapped in place
+        auto set_scale = [&](int factor){
+            scaled.set([factor](int x){ return x * factor; }, x);
+        };
+
+        set_scale(2);
+        x = 3;
+        std::cout << scaled.getCopy() << std::endl;     // 6
+        set_scale(10);
+        std::cout << scaled.getCopy() << std::endl;     // 30
+        x = 4;
+        std::cout << scaled.getCopy() << std::endl;     // 40
+
+        reactive::ObservableProperty<int> y = 5;
+        scaled.set([](int y){ return -y; }, y);
+        x = 5;
+        std::cout << scaled.getCopy() << std::endl;     // -5
+    }
+
+    void test_set_async(){
+        // manual executor - tasks run when we say
+        std::vector<std::function<void()>> tasks;
+        auto executor = [&](std::function<void()> task){
+            tasks.emplace_back(std::move(task));
+        };
+
+        reactive::ObservableProperty<int> x = 1;
+        reactive::ReactiveProperty<int> square = -1;
+        square.set_async(executor, [](int x){
+            return x*x;
+        }, x);
+
+        x = 2;
+        x = 3;
+
+        // finished in reverse order - only newest published
+        tasks[2]();
+        std::cout << square.getCopy() << std::endl;     // 9
+        tasks[1]();
+        tasks[0]();
+        std::cout << square.getCopy() << std::endl;     // 9
+
+        x = 4;
+        square = 0;     // cancel in flight
+        tasks[3]();
+        std::cout << square.getCopy() << std::endl;     // 0
+    }
+
     void test_all(){
         //test_simple();
         //test_update();
@@ -0,0 +1,172 @@
+#ifndef TEST_TESTSCHEDULER_H
+#define TEST_TESTSCHEDULER_H
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+
+#include <reactive/Scheduler.h>
+#include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
+#include <reactive/bind.h>
+
+class TestScheduler{
+public:
+    void test_simple(){
+        reactive::Scheduler scheduler;
+
+        reactive::ObservableProperty<int> x = 1;
+        reactive::ObservableProperty<int> y = 2;
+
+        int computed = 0;
+        reactive::ReactiveProperty<int> sum;
+        sum.set_deferred(scheduler, [&](int x, int y){
+            computed++;
+            return x + y;
+        }, x, y);
+        std::cout << "sum = " << sum.getCopy() << ", computed " << computed << std::endl;
+
+        for (int i = 0; i < 100; ++i) {
+            x = i;
+            y = i;
+        }
+        std::cout << "sum = " << sum.getCopy() << ", computed " << computed << std::endl;
+
+        scheduler.flush();
+        std::cout << "sum = " << sum.getCopy() << ", computed " << computed << std::endl;
+    }
+
+    void test_diamond(){
+        reactive::Scheduler scheduler;
+
+        reactive::ObservableProperty<int> x = 1;
+
+        reactive::ReactiveProperty<int> a;
+        a.set_deferred(scheduler, [](int x){ return x + 1; }, x);
+
+        reactive::ReactiveProperty<int> b;
+        b.set_deferred(scheduler, [](int x){ return x * 2; }, x);
+
+        int computed = 0;
+        reactive::ReactiveProperty<int> c;
+        c.set_deferred(scheduler, [&](int a, int b){
+            computed++;
+            return a + b;
+        }, a, b);
+
+        x = 10;
+        x = 20;
+        scheduler.flush();
+        std::cout << "c = " << c.getCopy() << ", computed " << computed << std::endl;      // 61, computed 2
+    }
+
+    void test_observe_bind(){
+        reactive::Scheduler scheduler;
+
+        reactive::ObservableProperty<int> x = 1;
+
+        auto unsubscribe = reactive::observe_deferred(scheduler, [](int x){
+            std::cout << "observe x = " << x << std::endl;
+        }, x);
+
+        struct Widget{
+            void show(int x){
+                std::cout << "widget x = " << x << std::endl;
+            }
+        };
+        auto widget = std::make_shared<Widget>();
+        reactive::bind_deferred(scheduler, widget, [](auto widget, int x){
+            widget->show(x);
+        }, x);
+
+        x = 2;
+        x = 3;
+        scheduler.flush();
+
+        unsubscribe();
+        widget.reset();
+        x = 4;
+        scheduler.flush();
+    }
+
+    void test_parallel(){
+        reactive::Scheduler scheduler;
+        threading::WorkStealingPool pool(4);
+
+        reactive::ObservableProperty<long long> x = 1;
+
+        // level 1 - independent nodes
+        std::vector<reactive::ReactiveProperty<long long>> nodes(1000);
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            nodes[i].set_deferred(scheduler, [i](long long x){ return x * (long long)i; }, x);
+        }
+
+        // level 2
+        reactive::ReactiveProperty<long long> sum;
+        sum.set_deferred(scheduler, [](long long a, long long b, long long c){ return a + b + c; }
+            , nodes[1], nodes[10], nodes[999]);
+
+        x = 2;
+        scheduler.flush(pool);
+
+        long long total = 0;
+        for (auto& node : nodes) {
+            total += node.getCopy();
+        }
+        std::cout << "total = " << total << ", sum = " << sum.getCopy() << std::endl;   // 999000, 2020
+    }
+
+    // input re-set deeper after child set - child still runs after its parents
+    void test_reset_deeper(){
+        reactive::Scheduler scheduler;
+
+        reactive::ObservableProperty<int> x = 1;
+        reactive::ReactiveProperty<int> p1, p2, q, child;
+        p1.set_deferred(scheduler, [](int x){ return x * 10; }, x);
+        p2.set_deferred(scheduler, [](int p1){ return p1 + 1; }, p1);
+        q.set([](int x){ return x; }, x);
+
+        int runs = 0;
+        child.set_deferred(scheduler, [&](int q, int x){ ++runs; return q + x; }, q, x);
+
+        q.set([](int p2){ return p2; }, p2);
+        scheduler.flush();
+
+        runs = 0;
+        x = 2;
+        scheduler.flush();
+        std::cout << "child = " << child.getCopy() << ", runs = " << runs << std::endl;     // 23, 1
+    }
+
+    void test_pool_exception(){
+        threading::WorkStealingPool pool(4);
+
+        std::atomic<int> finished{0};
+        try {
+            pool.parallel_for(100, [&](std::size_t i) {
+                if (i == 50) throw std::runtime_error("task 50");
+                finished.fetch_add(1);
+            });
+        } catch (const std::runtime_error& e) {
+            std::cout << "caught " << e.what() << ", finished <= 99 = " << (finished.load() <= 99) << std::endl;  // caught task 50, 1
+        }
+
+        // pool still usable
+        std::atomic<int> sum{0};
+        pool.parallel_for(100, [&](std::size_t i) { sum.fetch_add(int(i)); });
+        std::cout << "sum = " << sum.load() << std::endl;   // 4950
+    }
+
+    void test_all(){
+        test_simple();
+        test_diamond();
+        test_observe_bind();
+        test_parallel();
+        test_reset_deeper();
+        test_pool_exception();
+    }
+};
+
+#endif //TEST_TESTSCHEDULER_H
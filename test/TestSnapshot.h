@@ -0,0 +1,70 @@
+#ifndef TEST_TESTSNAPSHOT_H
+#define TEST_TESTSNAPSHOT_H
+
+#include <iostream>
+#include <array>
+#include <vector>
+
+#include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
+#include <reactive/dynamic_observer.h>
+
+class TestSnapshot{
+public:
+    using Big = std::array<int, 32>;
+
+    void test_event(){
+        reactive::ObservableProperty<Big, reactive::snapshot> big;
+
+        // snapshot convertible to const T&
+        big += [](const Big& value){
+            std::cout << "event " << value[0] << std::endl;
+        };
+
+        // observers share property's value, no copies
+        big += [&](const reactive::Snapshot<Big>& snapshot){
+            std::cout << "shared: " << (&snapshot.get() == &big.lock().get()) << std::endl;
+        };
+
+        Big value{};
+        value[0] = 1;
+        big = value;
+
+        std::cout << "value " << big.getCopy()[0] << std::endl;
+        {
+            auto write = big.write_lock();
+            write->at(0) = 2;
+        }
+        std::cout << "value " << big.lock()->at(0) << std::endl;
+    }
+
+    void test_observe(){
+        reactive::ObservableProperty<Big, reactive::snapshot> big;
+        reactive::ObservableProperty<int> k = 1;
+
+        reactive::ReactiveProperty<int> first;
+        first.set([](const Big& big, int k){ return big[0] * k; }, big, k);
+
+        reactive::ReactiveProperty<int, reactive::snapshot> first_blocking;
+        first_blocking.set<reactive::blocking>([](const Big& big){ return big[0]; }, big);
+
+        Big value{};
+        value[0] = 10;
+        big = value;
+        k = 3;
+        std::cout << first.getCopy() << " " << first_blocking.getCopy() << std::endl;    // 30 10
+
+        std::vector<reactive::ObservableProperty<Big, reactive::snapshot>> list(2);
+        auto unsubscribe = reactive::observe_each([](std::size_t index, const Big& old_value, const Big& new_value){
+            std::cout << "[" << index << "] " << old_value[0] << " -> " << new_value[0] << std::endl;
+        }, list);
+        list[1] = value;
+    }
+
+    void test_all(){
+        test_event();
+        test_observe();
+    }
+};
+
+#endif //TEST_TESTSNAPSHOT_H
@@ -0,0 +1,80 @@
+#ifndef TEST_TESTSUBSCRIPTION_H
+#define TEST_TESTSUBSCRIPTION_H
+
+#include <iostream>
+#include <memory>
+#include <array>
+
+#include <reactive/Subscription.h>
+#include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
+
+class TestSubscription{
+public:
+    void test_inline(){
+        auto counter = std::make_shared<int>(0);
+
+        reactive::Subscription s1 = [counter](){ ++*counter; };
+        reactive::Subscription s2 = s1;                 // copy
+        reactive::Subscription s3 = std::move(s1);      // move, s1 empty
+
+        s2();
+        s3();
+        s1();                                           // empty - nothing
+        std::cout << *counter << " " << bool(s1) << " " << counter.use_count() << std::endl;   // 2 0 3
+
+        s2 = nullptr;
+        s3.reset();
+        std::cout << counter.use_count() << std::endl;  // 1
+    }
+
+    void test_heap(){
+        std::array<long long, 8> big{};
+        reactive::Subscription s = [big](){
+            std::cout << "big " << big.size() << std::endl;
+        };
+        reactive::Subscription s2 = s;
+        s();
+        s2();
+    }
+
+    void test_target(){
+        struct Unsubscriber {
+            int id;
+            void operator()() const {
+                std::cout << "unsubscribe " << id << std::endl;
+            }
+        };
+
+        struct Other {
+            void operator()() const {}
+        };
+
+        reactive::Subscription s = Unsubscriber{42};
+        std::cout << s.target<Unsubscriber>()->id << " " << (s.target<Other>() == nullptr) << std::endl;   // 42 1
+        s();
+    }
+
+    void test_observe(){
+        reactive::ObservableProperty<int> x = 1;
+        reactive::Subscription unsubscribe = reactive::observe([](int x){
+            std::cout << "x = " << x << std::endl;
+        }, x);
+
+        x = 2;
+        unsubscribe();
+        x = 3;
+
+        std::cout << "sizeof(Subscription) = " << sizeof(reactive::Subscription)
+                  << ", sizeof(std::function<void()>) = " << sizeof(std::function<void()>) << std::endl;
+    }
+
+    void test_all(){
+        test_inline();
+        test_heap();
+        test_target();
+        test_observe();
+    }
+};
+
+#endif //TEST_TESTSUBSCRIPTION_H
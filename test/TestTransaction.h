@@ -0,0 +1,140 @@
+#ifndef TEST_TESTTRANSACTION_H
+#define TEST_TESTTRANSACTION_H
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+
+#include <reactive/ObservableProperty.h>
+#include <reactive/ReactiveProperty.h>
+#include <reactive/Transaction.h>
+
+class TestTransaction{
+public:
+    void test_simple(){
+        reactive::ObservableProperty<int> x1 = 0, x2 = 0, x3 = 0;
+
+        int recomputes = 0;
+        reactive::ReactiveProperty<int> sum;
+        sum.set([&](int x1, int x2, int x3){ recomputes++; return x1 + x2 + x3; }, x1, x2, x3);
+        recomputes = 0;
+
+        int notifications = 0;
+        sum += [&](int sum){ notifications++; std::cout << "sum = " << sum << std::endl; };
+        x1 += [](int x1){ std::cout << "x1 = " << x1 << std::endl; };
+
+        {
+            reactive::Transaction transaction;
+            x1 = 1;
+            x1 = 2;
+            x2 = 3;
+            x3.write_lock().get() = 4;
+            std::cout << "in transaction, sum = " << sum.getCopy() << std::endl;     // 0
+        }
+        // x1 = 2
+        // sum = 9
+        std::cout << "recomputes = " << recomputes << " notifications = " << notifications << std::endl;   // 1 1
+    }
+
+    void test_chain(){
+        reactive::ObservableProperty<int> x = 1;
+        reactive::ObservableProperty<int> y = 1;
+        reactive::ReactiveProperty<int> a, b;
+        a.set([](int x, int y){ return x + y; }, x, y);
+        b.set([](int a, int y){ return a * y; }, a, y);
+
+        int notifications = 0;
+        b += [&](int b){ notifications++; std::cout << "b = " << b << std::endl; };
+
+        {
+            reactive::Transaction transaction;
+            x = 2;
+            y = 3;
+            {
+                reactive::Transaction nested;
+                x = 4;
+            }
+        }
+        // b = 21
+        std::cout << "notifications = " << notifications << std::endl;     // 1
+    }
+
+    void test_blocking(){
+        reactive::ObservableProperty<int, reactive::blocking> x = 1;
+        reactive::ObservableProperty<int, reactive::snapshot> y = 1;
+        reactive::ReactiveProperty<int, reactive::blocking> sum;
+        sum.set([](int x, int y){ return x + y; }, x, y);
+        sum += [](int sum){ std::cout << "sum = " << sum << std::endl; };
+
+        reactive::Transaction transaction;
+        x = 10;
+        y = 20;
+        transaction.commit();       // sum = 30
+        x = 11;                     // sum = 31
+    }
+
+    // property destroyed with pending event - dropped
+    void test_destroyed(){
+        reactive::ObservableProperty<int> kept = 0;
+        kept += [](int kept){ std::cout << "kept = " << kept << std::endl; };
+
+        reactive::Transaction transaction;
+        {
+            reactive::ObservableProperty<int> temporary = 0;
+            temporary += [](int){ std::cout << "temporary - never" << std::endl; };
+            temporary = 1;
+            kept = 1;
+        }
+        transaction.commit();       // kept = 1
+    }
+
+    // dedup O(1) per write
+    void test_many(){
+        std::vector<reactive::ObservableProperty<int>> xs(10000, reactive::ObservableProperty<int>(0));
+        int notifications = 0;
+        for (auto& x : xs) x += [&](int){ notifications++; };
+
+        {
+            reactive::Transaction transaction;
+            for (int pass = 1; pass <= 3; ++pass) {
+                for (auto& x : xs) x = pass;
+            }
+        }
+        std::cout << "many notifications = " << notifications << std::endl;    // 10000
+    }
+
+    // handler throws on destructor commit - dropped, not std::terminate
+    void test_throw(){
+        reactive::ObservableProperty<int> x = 0;
+        x += [](int x){ if (x == 1) throw std::runtime_error("handler"); };
+        {
+            reactive::Transaction transaction;
+            x = 1;
+        }
+        try {
+            reactive::Transaction transaction;
+            x = 1;
+            x = 2;
+            x = 1;
+            transaction.commit();
+        } catch (const std::exception& e) {
+            std::cout << "commit throws " << e.what() << std::endl;   // commit throws handler
+        }
+        {
+            reactive::Transaction transaction;
+            x = 2;
+        }
+        std::cout << "after throw x = " << x.getCopy() << std::endl;     // 2
+    }
+
+    void test_all(){
+        test_simple();
+        test_chain();
+        test_blocking();
+        test_destroyed();
+        test_many();
+        test_throw();
+    }
+};
+
+#endif //TEST_TESTTRANSACTION_H
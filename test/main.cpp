@@ -8,11 +8,29 @@
 #include "TestBindableProperty.h"
 #include "TestReactiveProperty.h"
 #include "TestMultiObserver.h"
+#include "TestDynamicObserver.h"
+#include "TestExpression.h"
+#include "TestScheduler.h"
+#include "TestSubscription.h"
+#include "TestSnapshot.h"
+#include "TestOperators.h"
+#include "TestCoroutine.h"
+#include "TestTransaction.h"
+#include "TestObservableVector.h"
+#include "TestObservableMap.h"
+#include "TestMapView.h"
+#include "TestObservablePropertyArray.h"
+#include "TestIntrusive.h"
 
 
 #include "BenchmarkOwnedProperty.h"
 #include "BenchmarkReactivity.h"
 #include "BenchmarkDeferredContainer.h"
+#include "BenchmarkScheduler.h"
+#include "BenchmarkSnapshot.h"
+#include "BenchmarkMultiWriter.h"
+#include "BenchmarkOperators.h"
+#include "BenchmarkChangeDetection.h"
 
 
 int main() {
@@ -21,6 +39,19 @@ int main() {
     //TestObservableProperty().test_all();
 	//TestMultiObserver().test_all();
 	//TestReactiveProperty().test_all();
+	//TestDynamicObserver().test_all();
+	//TestExpression().test_all();
+	//TestScheduler().test_all();
+	//TestSubscription().test_all();
+	//TestSnapshot().test_all();
+	//TestOperators().test_all();
+	//TestCoroutine().test_all();		// C++20
+	//TestTransaction().test_all();
+	//TestObservableVector().test_all();
+	//TestObservableMap().test_all();
+	//TestMapView().test_all();
+	//TestObservablePropertyArray().test_all();
+	//TestIntrusive().test_all();
 	/*
     TestBindableProperty().test_all();
 
@@ -29,6 +60,11 @@ int main() {
 	BenchmarkOwnedProperty().benchmark_all();
 	*/
 	//BenchmarkDeferredContainer().benchmark_all();
+	//BenchmarkScheduler().benchmark_all();
+	//BenchmarkSnapshot().benchmark_all();
+	//BenchmarkMultiWriter().benchmark_all();
+	//BenchmarkOperators().benchmark_all();
+	//BenchmarkChangeDetection().benchmark_all();
 
 	BenchmarkReactivity().benchmark_all();
 	